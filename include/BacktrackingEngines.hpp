@@ -0,0 +1,331 @@
+#ifndef BACKTRACKING_ENGINES_HPP
+#define BACKTRACKING_ENGINES_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include "SolverEngine.hpp"
+
+/**
+ * @class BasicNaiveEngine
+ * @brief Plain backtracking that rescans row, column and box for every candidate
+ * @tparam Box Box side (see BasicBoard)
+ * @details Reference implementation; restarts the empty-cell scan at (0,0) on every level
+ */
+template<int Box>
+class BasicNaiveEngine final : public BasicSolverEngine<Box> {
+    using Base = BasicSolverEngine<Box>;
+    using Base::stats_;
+    using Base::guessDepth_;
+    using Base::cancelled;
+
+public:
+    using Board = BasicBoard<Box>; ///< Board type solved by this engine
+
+private:
+    Board *board_{nullptr}; ///< Board being solved
+
+    /**
+     * @brief Recursive search
+     * @tparam RecordSteps Record placements and removals into steps
+     * @tparam Profile Collect the detailed SolveStats counters
+     * @param steps Step sink (unused when RecordSteps is false)
+     * @return true if puzzle is solvable, false otherwise
+     */
+    template<bool RecordSteps, bool Profile>
+    bool search(StepSink *steps);
+
+public:
+    /**
+     * @brief Validate if placing number is legal
+     * @param board Board to check
+     * @param row Row index
+     * @param col Column index
+     * @param num Number to validate (1 to SIZE)
+     * @return true if no other cell of the row, column or box holds num
+     */
+    [[nodiscard]] static bool isValid(const Board &board, int row, int col, int num);
+
+    [[nodiscard]] EngineKind kind() const override { return EngineKind::Naive; }
+
+    bool solve(Board &board, StepSink *steps) override;
+};
+
+/**
+ * @class BasicMaskEngine
+ * @brief Shared candidate machinery for the bitmask-based engines
+ * @tparam Box Box side (see BasicBoard)
+ * @details
+ *   - Occupancy masks per row, column and box (one bit per digit, Board::Mask wide),
+ *     flipped on place/backtrack, so a candidate set is a single OR/NOT
+ *   - Live empty cells in a swap-remove array: O(1) take and restore
+ *   - Trail of propagated cells for O(1)-per-cell undo
+ *   - All sizes and loop bounds are compile-time constants of the instantiation
+ */
+template<int Box>
+class BasicMaskEngine : public BasicSolverEngine<Box> {
+public:
+    using Board = BasicBoard<Box>; ///< Board type solved by this engine
+
+protected:
+    using Mask = typename Board::Mask; ///< Digit set, bit (n - 1) represents digit n
+    using Index = typename Board::Index; ///< Cell index or position in empty_
+
+    static constexpr int SIZE = Board::SIZE; ///< Grid size (9 for 9x9)
+    static constexpr int CELLS = Board::CELLS; ///< Number of cells (81 for 9x9)
+    static constexpr Mask ALL_DIGITS = static_cast<Mask>((std::uint64_t{1} << SIZE) - 1); ///< Digits 1-SIZE set
+
+    Board *board_{nullptr}; ///< Board being solved
+
+    std::array<Mask, SIZE> rowMask_{}; ///< Digits used in each row
+    std::array<Mask, SIZE> colMask_{}; ///< Digits used in each column
+    std::array<Mask, SIZE> boxMask_{}; ///< Digits used in each box
+
+    std::array<Index, CELLS> empty_{}; ///< Empty cell indices, first emptyCount_ are live
+    std::array<Index, CELLS> emptyPos_{}; ///< Position of each cell inside empty_
+    int emptyCount_{0}; ///< Number of live entries in empty_
+
+    std::array<Index, CELLS> trail_{}; ///< empty_ positions filled by propagation (undo log)
+    int trailSize_{0}; ///< Number of entries in trail_
+
+    /**
+     * @brief Attach a board and rebuild masks and the empty-cell list from it
+     * @param board Board to solve
+     * @return false if two filled cells already conflict
+     */
+    bool attach(Board &board);
+
+    /// Digits that can still be placed at (row, col)
+    [[nodiscard]] Mask candidates(int row, int col) const {
+        const auto used = rowMask_[static_cast<size_t>(row)] | colMask_[static_cast<size_t>(col)]
+                          | boxMask_[static_cast<size_t>(Board::boxOf(row, col))];
+        return static_cast<Mask>(~used & ALL_DIGITS);
+    }
+
+    /// Digits that can still be placed at a cell index
+    [[nodiscard]] Mask candidates(int cell) const { return candidates(cell / SIZE, cell % SIZE); }
+
+    /// Digits already used in unit u (rows, then columns, then boxes; SIZE of each)
+    [[nodiscard]] Mask unitMask(int u) const {
+        if (u < SIZE) return rowMask_[static_cast<size_t>(u)];
+        if (u < 2 * SIZE) return colMask_[static_cast<size_t>(u - SIZE)];
+        return boxMask_[static_cast<size_t>(u - 2 * SIZE)];
+    }
+
+    /// Toggle digit bit in the masks of (row, col) - used for both place and backtrack
+    void flipMasks(int row, int col, Mask bit) {
+        rowMask_[static_cast<size_t>(row)] ^= bit;
+        colMask_[static_cast<size_t>(col)] ^= bit;
+        boxMask_[static_cast<size_t>(Board::boxOf(row, col))] ^= bit;
+    }
+
+    /**
+     * @brief Find the live empty cell with the fewest candidates
+     * @param bestCand Receives the candidate set of the chosen cell
+     * @param goodEnough Stop scanning once a cell has at most this many candidates
+     * @return Position of the chosen cell in empty_
+     * @note Counts one candidate test per scanned cell when Profile is set
+     */
+    template<bool Profile>
+    int mostConstrained(Mask &bestCand, int goodEnough);
+
+    /// Remove empty_[pos] from the live set in O(1) (swap with last live entry)
+    void takeEmpty(int pos) {
+        --emptyCount_;
+        swapEmpty(pos, emptyCount_);
+    }
+
+    /// Undo the matching takeEmpty(pos) in O(1)
+    void restoreEmpty(int pos) {
+        swapEmpty(pos, emptyCount_);
+        ++emptyCount_;
+    }
+
+    /// Swap two entries of empty_ and keep emptyPos_ in sync
+    void swapEmpty(int a, int b) {
+        auto &cellA = empty_[static_cast<size_t>(a)];
+        auto &cellB = empty_[static_cast<size_t>(b)];
+        std::swap(cellA, cellB);
+        emptyPos_[cellA] = static_cast<Index>(a);
+        emptyPos_[cellB] = static_cast<Index>(b);
+    }
+};
+
+// Members of the dependent bases used by the engines below (the search member
+// templates of BasicSolverEngine are called through this->template)
+#define SUDOKU_MASK_ENGINE_MEMBERS                                                                          \
+    using Base = BasicMaskEngine<Box>;                                                                      \
+    using typename Base::Mask;                                                                              \
+    using typename Base::Index;                                                                             \
+    using Base::SIZE;                                                                                       \
+    using Base::CELLS;                                                                                      \
+    using Base::ALL_DIGITS;                                                                                 \
+    using Base::stats_;                                                                                     \
+    using Base::guessDepth_;                                                                                \
+    using Base::cancelled;                                                                                  \
+    using Base::board_;                                                                                     \
+    using Base::empty_;                                                                                     \
+    using Base::emptyPos_;                                                                                  \
+    using Base::emptyCount_;                                                                                \
+    using Base::trail_;                                                                                     \
+    using Base::trailSize_;                                                                                 \
+    using Base::attach;                                                                                     \
+    using Base::candidates;                                                                                 \
+    using Base::unitMask;                                                                                   \
+    using Base::flipMasks;                                                                                  \
+    using Base::takeEmpty;                                                                                  \
+    using Base::restoreEmpty
+
+/**
+ * @class BasicBitmaskEngine
+ * @brief Row-major backtracking over the bitmask candidate sets
+ * @tparam Box Box side (see BasicBoard)
+ */
+template<int Box>
+class BasicBitmaskEngine final : public BasicMaskEngine<Box> {
+    SUDOKU_MASK_ENGINE_MEMBERS;
+
+    /**
+     * @brief Recursive search
+     * @tparam RecordSteps Record placements and removals into steps
+     * @tparam Profile Collect the detailed SolveStats counters
+     * @param cell First cell index (row-major) that may still be empty
+     * @param steps Step sink (unused when RecordSteps is false)
+     * @return true if puzzle is solvable, false otherwise
+     */
+    template<bool RecordSteps, bool Profile>
+    bool search(int cell, StepSink *steps);
+
+public:
+    using typename Base::Board;
+
+    [[nodiscard]] EngineKind kind() const override { return EngineKind::Bitmask; }
+
+    bool solve(Board &board, StepSink *steps) override;
+};
+
+/**
+ * @class BasicMrvEngine
+ * @brief Backtracking that branches on the most-constrained empty cell
+ * @tparam Box Box side (see BasicBoard)
+ */
+template<int Box>
+class BasicMrvEngine final : public BasicMaskEngine<Box> {
+    SUDOKU_MASK_ENGINE_MEMBERS;
+
+    /**
+     * @brief Recursive search
+     * @tparam RecordSteps Record placements and removals into steps
+     * @tparam Profile Collect the detailed SolveStats counters
+     * @param steps Step sink (unused when RecordSteps is false)
+     * @return true if puzzle is solvable, false otherwise
+     */
+    template<bool RecordSteps, bool Profile>
+    bool search(StepSink *steps);
+
+public:
+    using typename Base::Board;
+
+    [[nodiscard]] EngineKind kind() const override { return EngineKind::Mrv; }
+
+    bool solve(Board &board, StepSink *steps) override;
+};
+
+/**
+ * @class BasicPropagationEngine
+ * @brief MRV search with naked/hidden single propagation at every node
+ * @tparam Box Box side (see BasicBoard)
+ * @details Deductions are reported as StepKind::Deduced steps. The default engine
+ *          for every size; on 16x16 and 25x25 boards it is the only practical one.
+ */
+template<int Box>
+class BasicPropagationEngine final : public BasicMaskEngine<Box> {
+    SUDOKU_MASK_ENGINE_MEMBERS;
+
+    /**
+     * @brief Recursive search
+     * @tparam RecordSteps Record placements and removals into steps
+     * @tparam Profile Collect the detailed SolveStats counters
+     * @param steps Step sink (unused when RecordSteps is false)
+     * @return true if puzzle is solvable, false otherwise
+     */
+    template<bool RecordSteps, bool Profile>
+    bool search(StepSink *steps);
+
+    /**
+     * @brief Apply naked and hidden singles until nothing changes
+     * @param steps Step sink (unused when RecordSteps is false)
+     * @return false if a contradiction was found (caller must undo the trail)
+     */
+    template<bool RecordSteps, bool Profile>
+    bool propagate(StepSink *steps);
+
+    /**
+     * @brief Fill the empty cell at empty_[pos] as a deduction and log it on the trail
+     * @param pos Position in empty_
+     * @param bit Digit bit to place
+     * @param steps Step sink (unused when RecordSteps is false)
+     */
+    template<bool RecordSteps, bool Profile>
+    void deduce(int pos, Mask bit, StepSink *steps);
+
+    /**
+     * @brief Undo deductions until the trail is back to mark
+     * @param mark Trail size to restore
+     * @param steps Step sink (unused when RecordSteps is false)
+     */
+    template<bool RecordSteps>
+    void undoTrail(int mark, StepSink *steps);
+
+    /**
+     * @brief Recursive counting search; leaves the board as it found it
+     * @param limit Stop once this many solutions are found (> 0)
+     * @return Number of solutions found below this node, at most limit
+     */
+    std::uint64_t count(std::uint64_t limit);
+
+public:
+    using typename Base::Board;
+
+    [[nodiscard]] EngineKind kind() const override { return EngineKind::Propagation; }
+
+    bool solve(Board &board, StepSink *steps) override;
+
+    [[nodiscard]] std::uint64_t countSolutions(const Board &board, std::uint64_t limit) override;
+};
+
+#undef SUDOKU_MASK_ENGINE_MEMBERS
+
+/// @name 9x9 engines (registered in SolverRegistry)
+/// @{
+using NaiveEngine = BasicNaiveEngine<3>;
+using MaskEngine = BasicMaskEngine<3>;
+using BitmaskEngine = BasicBitmaskEngine<3>;
+using MrvEngine = BasicMrvEngine<3>;
+using PropagationEngine = BasicPropagationEngine<3>;
+/// @}
+
+// Instantiated for every supported size in BacktrackingEngines.cpp
+extern template class BasicNaiveEngine<2>;
+extern template class BasicNaiveEngine<3>;
+extern template class BasicNaiveEngine<4>;
+extern template class BasicNaiveEngine<5>;
+extern template class BasicMaskEngine<2>;
+extern template class BasicMaskEngine<3>;
+extern template class BasicMaskEngine<4>;
+extern template class BasicMaskEngine<5>;
+extern template class BasicBitmaskEngine<2>;
+extern template class BasicBitmaskEngine<3>;
+extern template class BasicBitmaskEngine<4>;
+extern template class BasicBitmaskEngine<5>;
+extern template class BasicMrvEngine<2>;
+extern template class BasicMrvEngine<3>;
+extern template class BasicMrvEngine<4>;
+extern template class BasicMrvEngine<5>;
+extern template class BasicPropagationEngine<2>;
+extern template class BasicPropagationEngine<3>;
+extern template class BasicPropagationEngine<4>;
+extern template class BasicPropagationEngine<5>;
+
+#endif // BACKTRACKING_ENGINES_HPP
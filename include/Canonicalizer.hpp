@@ -0,0 +1,93 @@
+#ifndef CANONICALIZER_HPP
+#define CANONICALIZER_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "SudokuBoard.hpp"
+
+/**
+ * @struct BoardTransform
+ * @brief Element of the Sudoku symmetry group: transposition, band/row and
+ *        stack/column permutations, digit relabelling
+ * @details Cell (i, j) of the image is digits[source(rows[i], cols[j])], where
+ *          source reads the original board transposed if transpose is set.
+ */
+struct BoardTransform {
+    bool transpose{false}; ///< Read the source board column-major
+    std::array<std::uint8_t, 9> rows{0, 1, 2, 3, 4, 5, 6, 7, 8}; ///< Image row i comes from source row rows[i]
+    std::array<std::uint8_t, 9> cols{0, 1, 2, 3, 4, 5, 6, 7, 8}; ///< Image column j comes from source column cols[j]
+    std::array<std::uint8_t, 10> digits{0, 1, 2, 3, 4, 5, 6, 7, 8, 9}; ///< Relabelling, digits[0] == 0
+
+    /// Image of a board
+    [[nodiscard]] SudokuBoard apply(const SudokuBoard &board) const;
+
+    /// Preimage of a board (apply() undone)
+    [[nodiscard]] SudokuBoard invert(const SudokuBoard &board) const;
+};
+
+/**
+ * @class Canonicalizer
+ * @brief Maps a board to the minimal representative of its symmetry class
+ * @details
+ *   - The group: transposition, the 3! band orders and 3! row orders per band,
+ *     the same for stacks and columns, and the 9! relabellings (2 * 6^8 * 9!)
+ *   - Order: row-major lexicographic, digits relabelled in order of first
+ *     appearance (the smallest labelling for a fixed geometry), empty cells
+ *     after every digit so clue-rich rows lead and prune the search early
+ *   - Search: the best first row is found over all 18 (transpose, row) choices
+ *     with a depth-first walk of the 1296 column orders, pruned against the
+ *     best prefix; every tying (geometry, labelling) then extends row by row and
+ *     only those matching the smallest next row survive
+ *   - Equivalent boards give identical canonical boards; the transform found
+ *     maps the input onto it (BoardTransform::invert maps back)
+ *   - Candidate lists are reused, so warm calls do not allocate
+ */
+class Canonicalizer {
+public:
+    static constexpr std::size_t MAX_CANDIDATES = 1U << 14; ///< Search budget per row (very sparse boards exceed it)
+    static constexpr std::uint8_t EMPTY_KEY = 10; ///< Sort key of empty cells (after digits 1-9)
+
+    /**
+     * @struct Candidate
+     * @brief Partial transform sharing the smallest rows found so far
+     */
+    struct Candidate {
+        std::uint8_t transpose{0}; ///< Source read transposed
+        std::uint8_t next{1}; ///< Next free digit label
+        std::uint8_t bands{0}; ///< Source bands used (bit mask)
+        std::array<std::uint8_t, 9> rows{}; ///< Source row of each fixed image row
+        std::array<std::uint8_t, 9> cols{}; ///< Source column of each image column
+        std::array<std::uint8_t, 10> digits{}; ///< Labels given so far (0 = not yet)
+    };
+
+private:
+    SudokuBoard board_; ///< Board being canonicalised
+    std::vector<Candidate> current_; ///< Candidates tying after the rows placed so far
+    std::vector<Candidate> next_; ///< Candidates being built for the next row
+    std::array<std::uint8_t, 9> best_{}; ///< Smallest row (sort keys) at the current level
+    std::array<std::uint8_t, 9> path_{}; ///< Sort keys of the first-row walk
+
+    /**
+     * @brief Collect the column orders giving the smallest first row
+     * @param candidate Transform being built (transpose and first source row set)
+     * @param position Image column to fill next
+     * @param stacks Source stacks used so far (bit mask)
+     */
+    void firstRow(Candidate &candidate, int position, std::uint8_t stacks);
+
+public:
+    /**
+     * @brief Canonical form of a board
+     * @param board Board (0 = empty)
+     * @param canonical Receives the minimal representative
+     * @param transform Receives a transform with transform.apply(board) == canonical;
+     *        its digit map is a full permutation (digits absent from the board get
+     *        the remaining labels in increasing order)
+     * @return false if the search budget was exceeded (outputs unspecified)
+     */
+    bool canonicalize(const SudokuBoard &board, SudokuBoard &canonical, BoardTransform &transform);
+};
+
+#endif // CANONICALIZER_HPP
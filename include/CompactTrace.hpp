@@ -0,0 +1,158 @@
+#ifndef COMPACT_TRACE_HPP
+#define COMPACT_TRACE_HPP
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <span>
+#include <type_traits>
+#include <vector>
+#include "SolverEngine.hpp"
+
+/**
+ * @class BasicCompactTrace
+ * @brief Solve trace stored as one 16-bit code per step (32-bit for 25x25)
+ * @tparam Box Box side of the traced board (see BasicBoard)
+ * @details
+ *   - Code layout: cell index, then value, then the deduced bit and the bounce bit
+ *     (placement immediately undone: expands to two steps). Field widths follow the
+ *     board size; on 9x9 that is bits 0-6 cell (0-80), bits 7-10 value (0-9),
+ *     bit 11 deduced, bit 12 bounce
+ *   - 2 bytes per step instead of sizeof(SolveStep); with bounce coalescing, the
+ *     dead-end "place, fail, remove" pairs that dominate backtracking traces cost
+ *     2 bytes per pair
+ *   - Iterates as SolveStep values, in the order the engine produced them
+ *   - Is a StepSink, so engines record into it directly
+ */
+template<int Box>
+class BasicCompactTrace final : public StepSink {
+    using Board = BasicBoard<Box>; ///< Traced board type
+
+    static constexpr int CELL_BITS = std::bit_width(static_cast<unsigned>(Board::CELLS - 1)); ///< Bits of a cell index
+    static constexpr int VALUE_BITS = std::bit_width(static_cast<unsigned>(Board::SIZE)); ///< Bits of a value
+
+public:
+    /// One encoded step (or bounce pair)
+    using Code = std::conditional_t<(CELL_BITS + VALUE_BITS + 2 <= 16), std::uint16_t, std::uint32_t>;
+
+    static constexpr Code CELL_MASK = (1U << CELL_BITS) - 1; ///< Cell index bits
+    static constexpr int VALUE_SHIFT = CELL_BITS; ///< Position of the value bits
+    static constexpr Code VALUE_MASK = (1U << VALUE_BITS) - 1; ///< Value bits (after shifting)
+    static constexpr Code DEDUCED_BIT = 1U << (CELL_BITS + VALUE_BITS); ///< StepKind::Deduced
+    static constexpr Code BOUNCE_BIT = 1U << (CELL_BITS + VALUE_BITS + 1); ///< Placement followed by its removal
+
+    /// Encode a single step (never sets BOUNCE_BIT)
+    static constexpr Code encode(const SolveStep &step) {
+        const auto cell = static_cast<unsigned>(Board::index(step.row, step.col));
+        const auto value = static_cast<unsigned>(step.value) << VALUE_SHIFT;
+        const unsigned deduced = step.kind == StepKind::Deduced ? DEDUCED_BIT : 0U;
+        return static_cast<Code>(cell | value | deduced);
+    }
+
+    /// Decode the first step of a code (the placement, for bounce codes)
+    static constexpr SolveStep decode(Code code) {
+        const int cell = static_cast<int>(code & CELL_MASK);
+        return {cell / Board::SIZE, cell % Board::SIZE, static_cast<int>((code >> VALUE_SHIFT) & VALUE_MASK),
+                (code & DEDUCED_BIT) != 0 ? StepKind::Deduced : StepKind::Guess};
+    }
+
+    /**
+     * @class Iterator
+     * @brief Forward iterator expanding codes into SolveStep values
+     */
+    class Iterator {
+        const Code *code_{nullptr}; ///< Current code
+        bool second_{false}; ///< On the removal half of a bounce code
+
+    public:
+        using iterator_category = std::forward_iterator_tag; ///< Iterator traits
+        using value_type = SolveStep; ///< Iterator traits
+        using difference_type = std::ptrdiff_t; ///< Iterator traits
+        using pointer = void; ///< Iterator traits (values are synthesized)
+        using reference = SolveStep; ///< Iterator traits (values are synthesized)
+
+        Iterator() = default;
+
+        /// Start at code
+        explicit Iterator(const Code *code) : code_(code) {
+        }
+
+        SolveStep operator*() const {
+            SolveStep step = decode(*code_);
+            if (second_) step.value = 0;
+            return step;
+        }
+
+        Iterator &operator++() {
+            if ((*code_ & BOUNCE_BIT) != 0 && !second_) {
+                second_ = true;
+            } else {
+                ++code_;
+                second_ = false;
+            }
+            return *this;
+        }
+
+        Iterator operator++(int) {
+            Iterator old = *this;
+            ++*this;
+            return old;
+        }
+
+        bool operator==(const Iterator &) const = default;
+    };
+
+private:
+    std::vector<Code> codes_; ///< Encoded steps
+    std::size_t steps_{0}; ///< Number of steps (bounce codes count twice)
+    bool coalesce_{true}; ///< Merge placement + immediate removal into one code
+
+public:
+    /**
+     * @brief Create an empty trace
+     * @param coalesce Merge each placement that is undone right away into one bounce code
+     */
+    explicit BasicCompactTrace(bool coalesce = true) : coalesce_(coalesce) {
+    }
+
+    /// Append a step, merging it into the previous code when it undoes that placement
+    void push(const SolveStep &step) override;
+
+    /// Remove all steps (keeps the allocation)
+    void clear() {
+        codes_.clear();
+        steps_ = 0;
+    }
+
+    /// Number of steps
+    [[nodiscard]] std::size_t size() const { return steps_; }
+
+    /// No steps recorded
+    [[nodiscard]] bool empty() const { return steps_ == 0; }
+
+    /// Raw codes, e.g. for writing the trace to a file
+    [[nodiscard]] std::span<const Code> codes() const { return codes_; }
+
+    /// Bytes used by the codes
+    [[nodiscard]] std::size_t bytes() const { return codes_.size() * sizeof(Code); }
+
+    /// First step
+    [[nodiscard]] Iterator begin() const { return Iterator(codes_.data()); }
+
+    /// Past the last step
+    [[nodiscard]] Iterator end() const { return Iterator(codes_.data() + codes_.size()); }
+};
+
+/// Trace of a 9x9 solve (16-bit codes)
+using CompactTrace = BasicCompactTrace<3>;
+
+static_assert(sizeof(CompactTrace::Code) == 2 && CompactTrace::BOUNCE_BIT == 1U << 12, "9x9 code layout is fixed");
+static_assert(sizeof(BasicCompactTrace<4>::Code) == 2 && sizeof(BasicCompactTrace<5>::Code) == 4);
+
+extern template class BasicCompactTrace<2>;
+extern template class BasicCompactTrace<3>;
+extern template class BasicCompactTrace<4>;
+extern template class BasicCompactTrace<5>;
+
+#endif // COMPACT_TRACE_HPP
@@ -0,0 +1,135 @@
+#ifndef DIFFICULTY_RATER_HPP
+#define DIFFICULTY_RATER_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include "SudokuBoard.hpp"
+
+/**
+ * @enum Technique
+ * @brief Human solving techniques, easiest first (the rater's ladder order)
+ */
+enum class Technique : std::uint8_t {
+    HiddenSingle, ///< Only one place for a digit in a row, column or box
+    NakedSingle, ///< Only one candidate left in a cell
+    Pointing, ///< Digit of a box confined to one row/column: remove it from the rest of the line
+    Claiming, ///< Digit of a row/column confined to one box: remove it from the rest of the box
+    NakedPair, ///< Two cells of a unit with the same two candidates
+    XWing, ///< Digit in two rows confined to the same two columns (or vice versa)
+    HiddenPair, ///< Two digits confined to the same two cells of a unit
+    NakedTriple, ///< Three cells of a unit with three candidates between them
+    Swordfish, ///< X-Wing over three rows/columns
+    HiddenTriple, ///< Three digits confined to the same three cells of a unit
+    XYWing, ///< Bivalue pivot with two bivalue pincers sharing a third digit
+    XYChain, ///< Chain of bivalue cells whose ends both hold the eliminated digit
+    Trial ///< Beyond the ladder: needs guessing (the puzzle is left unsolved)
+};
+
+/// Number of Technique values
+inline constexpr std::size_t TECHNIQUE_COUNT = static_cast<std::size_t>(Technique::Trial) + 1;
+
+/**
+ * @enum Difficulty
+ * @brief Coarse buckets of the rating, used to sort generated puzzles
+ */
+enum class Difficulty : std::uint8_t {
+    Easy, ///< Singles only
+    Medium, ///< Pointing, claiming, naked pairs
+    Hard, ///< X-Wing, hidden pairs, triples, Swordfish, XY-Wing
+    Expert, ///< XY-Chain
+    Extreme ///< Beyond the ladder
+};
+
+/// Number of Difficulty values
+inline constexpr std::size_t DIFFICULTY_COUNT = static_cast<std::size_t>(Difficulty::Extreme) + 1;
+
+/**
+ * @struct Rating
+ * @brief Result of DifficultyRater::rate()
+ */
+struct Rating {
+    bool valid{false}; ///< Givens are consistent (false: the fields below are meaningless)
+    bool solved{false}; ///< The ladder solved the puzzle (false: stuck, hardest == Trial)
+    Technique hardest{Technique::HiddenSingle}; ///< Hardest technique needed
+    double score{0.0}; ///< Numeric rating: score of the hardest technique
+    Difficulty difficulty{Difficulty::Easy}; ///< Bucket of the hardest technique
+    std::array<std::uint16_t, TECHNIQUE_COUNT> uses{}; ///< Successful applications per technique
+};
+
+/**
+ * @class DifficultyRater
+ * @brief Grades puzzles by the human techniques needed to solve them
+ * @details
+ *   - Candidate grid kept incrementally: a 9-bit candidate mask per cell and, per
+ *     unit (9 rows, 9 columns, 9 boxes) and digit, a 9-bit mask of the positions
+ *     that still allow it. Placing a digit or removing a candidate updates both
+ *     in O(units), so no technique rebuilds anything
+ *   - The ladder is tried from the easiest technique every time one makes
+ *     progress; singles apply everything they find in one sweep, the others
+ *     apply their first deduction
+ *   - The rating is the score of the hardest technique used (Sudoku Explainer
+ *     scale: 1.5 hidden single ... 4.2 XY-Wing, 5.0 XY-Chain, 10.0 beyond)
+ *   - Contradictions (no candidate left, digit with no place) mark the rating invalid
+ *   - No allocation; reuse one instance per thread for batches
+ */
+class DifficultyRater {
+public:
+    using Mask = std::uint16_t; ///< Digit set (bit d - 1 = digit d) or position set within a unit
+
+private:
+    std::array<std::uint8_t, SudokuBoard::CELLS> values_{}; ///< Placed digits (0 = open)
+    std::array<Mask, SudokuBoard::CELLS> cand_{}; ///< Candidates of open cells (0 once placed)
+    std::array<std::array<Mask, 9>, 27> places_{}; ///< [unit][digit - 1] = positions still allowing it
+    std::array<Mask, 27> placed_{}; ///< Digits placed per unit
+    int open_{0}; ///< Cells without a digit
+    bool broken_{false}; ///< A contradiction was found
+
+    void place(int cell, int digit);
+    bool eliminate(int cell, int digit);
+    bool hiddenSingles();
+    bool nakedSingles();
+    bool pointing();
+    bool claiming();
+    bool nakedSubset(int size);
+    bool hiddenSubset(int size);
+    bool fish(int size);
+    bool xyWing();
+    bool xyChain();
+
+    /**
+     * @brief Apply one rung of the ladder
+     * @param technique Technique to try
+     * @return true if it placed a digit or removed a candidate
+     */
+    bool apply(Technique technique);
+
+public:
+    /**
+     * @brief Rate a puzzle
+     * @param puzzle Puzzle (0 = empty); should have a unique solution
+     * @return Hardest technique, score, bucket and per-technique counts
+     */
+    [[nodiscard]] Rating rate(const SudokuBoard &puzzle);
+
+    /// Board reached by the last rate() (the solution if Rating::solved)
+    [[nodiscard]] SudokuBoard board() const;
+
+    /// Candidates of a cell after the last rate() (0 for placed cells)
+    [[nodiscard]] Mask candidates(int cell) const { return cand_[static_cast<std::size_t>(cell)]; }
+
+    /// Score of a technique on the rating scale
+    [[nodiscard]] static double score(Technique technique);
+
+    /// Difficulty bucket of a technique
+    [[nodiscard]] static Difficulty difficulty(Technique technique);
+
+    /// Display name of a technique
+    [[nodiscard]] static std::string_view name(Technique technique);
+
+    /// Display name of a difficulty bucket
+    [[nodiscard]] static std::string_view name(Difficulty difficulty);
+};
+
+#endif // DIFFICULTY_RATER_HPP
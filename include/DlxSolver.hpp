@@ -0,0 +1,89 @@
+#ifndef DLX_SOLVER_HPP
+#define DLX_SOLVER_HPP
+
+#include <array>
+#include <cstdint>
+#include "SolverEngine.hpp"
+
+/**
+ * @class DlxSolver
+ * @brief Exact-cover Sudoku solver using Knuth's Dancing Links (Algorithm X)
+ * @details
+ *   - 324 constraint columns: cell, row-digit, column-digit, box-digit
+ *   - 729 candidate rows (cell x digit), 4 nodes each
+ *   - All nodes live in fixed index-based arrays built once in the constructor;
+ *     solving never allocates (step sink aside)
+ *   - Chooses the column with the fewest rows (Knuth's S heuristic), which gives
+ *     predictable worst-case behaviour on adversarial puzzles
+ *   - The link structure is fully restored after every solve, so one instance
+ *     can be reused for any number of puzzles
+ */
+class DlxSolver final : public SolverEngine {
+    static constexpr int COLUMNS = 324; ///< Exact-cover constraints
+    static constexpr int ROWS = 729; ///< Candidates (81 cells x 9 digits)
+    static constexpr int ROOT = 0; ///< Root header node
+    static constexpr int NODES = 1 + COLUMNS + ROWS * 4; ///< Root + headers + row nodes
+
+    std::array<int, NODES> left_{}; ///< Left link
+    std::array<int, NODES> right_{}; ///< Right link
+    std::array<int, NODES> up_{}; ///< Up link
+    std::array<int, NODES> down_{}; ///< Down link
+    std::array<int, NODES> column_{}; ///< Column header of each node
+    std::array<int, NODES> rowOf_{}; ///< Candidate id (cell * 9 + digit - 1) of each node
+    std::array<int, COLUMNS + 1> size_{}; ///< Live rows per column
+    std::array<bool, COLUMNS + 1> covered_{}; ///< Column covered by a given cell
+
+    std::array<int, 81> solution_{}; ///< Chosen row nodes, one per search level
+    int depth_{0}; ///< Number of entries in solution_
+
+    std::array<int, 81> givens_{}; ///< Row nodes of the covered given cells
+    int givenCount_{0}; ///< Number of entries in givens_
+
+    /// Remove column c and every row that intersects it
+    void cover(int c);
+
+    /// Exact inverse of cover(c)
+    void uncover(int c);
+
+    /// First node of candidate row id
+    static constexpr int rowNode(int id) { return 1 + COLUMNS + id * 4; }
+
+    /**
+     * @brief Algorithm X search
+     * @tparam Profile Collect the detailed SolveStats counters
+     * @param steps Step sink, may be nullptr
+     * @return true if an exact cover was found (structure already restored)
+     */
+    template<bool Profile>
+    bool search(StepSink *steps);
+
+    /**
+     * @brief Algorithm X search that keeps going after a cover is found
+     * @param limit Stop once this many covers are found (> 0)
+     * @return Number of covers found, at most limit (structure already restored)
+     */
+    std::uint64_t count(std::uint64_t limit);
+
+    /**
+     * @brief Cover the rows of every filled cell
+     * @param board Puzzle
+     * @return false if two givens claim the same constraint or a given is above 9
+     *         (call uncoverGivens() anyway)
+     */
+    bool coverGivens(const SudokuBoard &board);
+
+    /// Undo coverGivens() in reverse order
+    void uncoverGivens();
+
+public:
+    /// Build the full 729 x 324 link structure
+    DlxSolver();
+
+    [[nodiscard]] EngineKind kind() const override { return EngineKind::Dlx; }
+
+    bool solve(SudokuBoard &board, StepSink *steps) override;
+
+    [[nodiscard]] std::uint64_t countSolutions(const SudokuBoard &board, std::uint64_t limit) override;
+};
+
+#endif // DLX_SOLVER_HPP
@@ -1,10 +1,26 @@
 #ifndef MAIN_WINDOW_HPP
 #define MAIN_WINDOW_HPP
 
+#include <QByteArray>
 #include <QMainWindow>
+#include <QPointer>
+#include <QThread>
 #include <QTimer>
+#include <atomic>
+#include <chrono>
+#include <functional>
 #include <memory>
+#include <random>
+#include "DifficultyRater.hpp"
+#include "ParallelSolver.hpp"
+#include "PuzzleCorpus.hpp"
+#include "PuzzleGenerator.hpp"
+#include "Playback.hpp"
+#include "SolutionCache.hpp"
 #include "Sudoku.hpp"
+#include "ThreadPool.hpp"
+
+Q_DECLARE_METATYPE(SolveStats)
 
 namespace Ui {
     class MainWindow;
@@ -15,8 +31,8 @@ namespace Ui {
  * @brief Main application window
  * @details
  *   - Contains Sudoku grid, buttons, and labels
- *   - Handles solving logic (fast and animated)
- *   - Manages puzzle selection and UI updates
+ *   - Handles solving logic (fast and animated) for 4x4, 9x9, 16x16 and 25x25 boards
+ *   - Generates new puzzles (9x9), opens puzzle files of any size and manages UI updates
  *   - UI definition is in MainWindow.ui (Qt Designer format)
  */
 class MainWindow : public QMainWindow {
@@ -27,39 +43,146 @@ private:
 
     // Solving logic
     QTimer *animTimer_{nullptr}; ///< Animation timer (60 FPS)
-    std::vector<SolveStep> solveSteps_; ///< Recorded solving steps
-    size_t currentStep_{0}; ///< Current step in animation
+    std::unique_ptr<Playback> playback_; ///< Solver-to-animation queue and seekable trace, sized like the grid
+    bool animLoaded_{false}; ///< playback_ holds the trace of the puzzle on the grid
+    qint64 playedMs_{0}; ///< Playback time spent against the target duration
+
+    static constexpr std::chrono::milliseconds FRAME_BUDGET{10}; ///< Step application time per 16 ms frame
+    std::unique_ptr<ThreadPool> solvePool_; ///< Workers for the Solve button (null on single-core machines)
+    std::unique_ptr<ParallelSolver> parallelSolver_; ///< Root-split search on solvePool_
+    Sudoku solver_; ///< Single-threaded 9x9 solver reused by every job (engine and buffers survive)
+    SolutionCache cache_; ///< Solutions of earlier puzzles and their symmetric copies (kept across runs)
+
+    // Background solving
+    QPointer<QThread> solveThread_; ///< Worker running the current solve (null when idle)
+    std::atomic<bool> cancelSolve_{false}; ///< Cancellation token polled by the engines
+    quint64 solveJob_{0}; ///< Id of the current job; results of older jobs are dropped
+    QByteArray solveInput_; ///< Cell values the current job started from (row-major, any size)
+    bool streaming_{false}; ///< Current job is the animation producer
+
+    // Puzzle source
+    PuzzleGenerator generator_; ///< Fresh unique puzzles for the New Puzzle button
+    DifficultyRater rater_; ///< Grades puzzles generated by clue count
+    PuzzleCorpus corpus_; ///< Optional mapped corpus New Puzzle draws from (see openCorpus())
+    std::mt19937_64 corpusRng_{std::random_device{}()}; ///< Picks corpus records
+
+    /**
+     * @brief Solver engine picked in the engine combo box
+     * @return Engine used by onSolve() and onAnimate()
+     */
+    [[nodiscard]] EngineKind selectedEngine() const;
+
+    /**
+     * @brief Run a solve job on a worker thread
+     * @param job Work to run; must poll cancelSolve_ (through an engine) and emit a result signal
+     * @details The window stays responsive; results come back as queued signals
+     */
+    void startSolveJob(const std::function<void()> &job);
 
-    // Puzzle collection
-    static const std::vector<std::vector<std::vector<int> > > PUZZLES; ///< Example puzzles
+    /**
+     * @brief Abort the in-flight solve, if any, and drop its result
+     * @details Engines poll the token at every node, so this blocks for milliseconds at most
+     */
+    void cancelSolve();
+
+    /// Join the finished (or cancelled) solve worker and forget it
+    void releaseSolveThread();
+
+    /// Stop the animation timer and restore the button labels
+    void stopAnimation();
 
     /**
-     * @brief Solve current puzzle instantly
-     * @details Shows solution with elapsed time
+     * @brief Solve current puzzle on a worker thread
+     * @details Shows solution with elapsed time; 9x9 puzzles use the root-split
+     *          parallel search when more than one hardware thread is available,
+     *          and come from cache_ if solved before (in any symmetric form).
+     *          Other sizes run the selected engine on one thread.
+     *          Profiling is on, so the result carries the detailed SolveStats.
+     *          Clicking again while the solve runs stops it.
      */
-    void onSolve() const;
+    void onSolve();
 
     /**
      * @brief Start animated solving
-     * @details Shows step-by-step solving process
+     * @details A worker thread streams steps through playback_ while the timer
+     *          plays them back, so playback starts at once. The whole trace is kept
+     *          for seeking (2 bytes per step up to 16x16, 4 on 25x25, plus periodic
+     *          board snapshots), so memory grows with the solve. Clicking again
+     *          pauses; the next click resumes while steps remain, and starts over
+     *          once the trace has been played.
      */
     void onAnimate();
 
     /**
-     * @brief Load a random puzzle
+     * @brief Show the result of a background solve
+     * @param job Job id (stale jobs are ignored)
+     * @param solved Solution found
+     * @param cached Solution came from the cache (stats are empty)
+     * @param cancelled Solve was stopped before it finished
+     * @param solution Solved cell values, row-major (valid if solved)
+     * @param elapsedMs Solve time in milliseconds
+     * @param stats Profiled search statistics (summed over workers for parallel solves)
+     */
+    void onSolveFinished(quint64 job, bool solved, bool cached, bool cancelled, const QByteArray &solution,
+                         qint64 elapsedMs, const SolveStats &stats);
+
+    /**
+     * @brief Load a freshly generated puzzle
+     * @details Unique solution, in the bucket picked in difficultyCombo or, for "Any
+     *          difficulty", with the clue count from cluesSpin (minimal puzzles may keep
+     *          more); the status line shows the rating
      */
-    void onNewPuzzle() const;
+    void onNewPuzzle();
 
     /**
      * @brief Clear user input (keep given cells)
      */
-    void onClear() const;
+    void onClear();
+
+    /**
+     * @brief Switch to an empty board of the size picked in sizeCombo
+     * @param box Box side (2-5)
+     */
+    void onBoardSize(int box);
+
+    /// Pick a puzzle file and load it (see openPuzzle())
+    void onOpenPuzzle();
+
+    /// Sync sizeCombo and the 9x9-only puzzle controls with the grid size
+    void updateSizeControls();
 
     /**
-     * @brief Process next animation step
+     * @brief Process next animation frame
+     * @details Applies stepsPerFrame() steps within FRAME_BUDGET, redraws each
+     *          touched cell once and updates the status label once
      */
     void onAnimStep();
 
+    /**
+     * @brief Steps to apply in the coming frame
+     * @return speedSpin value, or the remaining steps spread over the remaining
+     *         target duration when durationSpin is set
+     */
+    size_t stepsPerFrame();
+
+    /// Sync the slider and step counter with playback_
+    void updatePlayback() const;
+
+    /// Drop the trace when the grid gets a different puzzle (and resize playback_ with the grid)
+    void resetPlayback();
+
+    /**
+     * @brief Jump to a step of the trace (slider)
+     * @param step Number of steps to show
+     */
+    void onSeek(int step);
+
+    /// Pause and go back one step
+    void onStepBackward();
+
+    /// Pause and go forward one step
+    void onStepForward();
+
 public:
     /**
      * @brief Constructor
@@ -67,8 +190,34 @@ public:
      */
     explicit MainWindow(QWidget *parent = nullptr);
 
-    /// Destructor
+    /// Destructor - stops and joins the solve worker, then saves the solution cache
     ~MainWindow() override;
+
+    /**
+     * @brief Draw New Puzzle boards from a binary corpus instead of generating them
+     * @param path Corpus file (see sudoku_corpus)
+     * @return true if the file was mapped; the status line reports the outcome
+     * @details Random records of the whole corpus, or of the selected difficulty
+     *          bucket when the corpus is rated; unrated corpora with a difficulty
+     *          selected, and empty buckets, fall back to the generator.
+     */
+    bool openCorpus(const QString &path);
+
+    /**
+     * @brief Load a puzzle from a text file
+     * @param path File whose first line (after '#' comments) is a one-line puzzle
+     *        of 16, 81, 256 or 625 characters (see BasicBoard::parse())
+     * @return true if the puzzle was loaded; the grid takes its size
+     */
+    bool openPuzzle(const QString &path);
+
+    /// File the solution cache is loaded from and saved to (in the application data directory)
+    [[nodiscard]] static QString cachePath();
+
+signals:
+    /// Emitted from the solve worker when a fast solve ends
+    void solveFinished(quint64 job, bool solved, bool cached, bool cancelled, const QByteArray &solution,
+                       qint64 elapsedMs, const SolveStats &stats);
 };
 
 #endif // MAIN_WINDOW_HPP
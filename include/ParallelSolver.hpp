@@ -0,0 +1,109 @@
+#ifndef PARALLEL_SOLVER_HPP
+#define PARALLEL_SOLVER_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "SolverEngine.hpp"
+#include "ThreadPool.hpp"
+
+/**
+ * @class ParallelSolver
+ * @brief Root-split search of a single puzzle on a thread pool
+ * @details
+ *   - The first few branching levels are expanded breadth-first (most-constrained
+ *     cell first) into independent subtrees, roughly SPLIT_FACTOR per worker
+ *   - Each subtree is searched by the worker's own engine instance (no sharing)
+ *   - solve(): the first subtree to find a solution cancels all siblings
+ *   - countSolutions(): subtree counts are summed; siblings are cancelled once
+ *     the limit is reached
+ *   - Blocking calls: must not be made from a worker of the same pool
+ *   - Engines and split buffers are kept between calls: once warmed up, a solve
+ *     does not touch the heap
+ */
+class ParallelSolver {
+    static constexpr std::size_t SPLIT_FACTOR = 8; ///< Target subtrees per worker
+    static constexpr int MAX_SPLIT_DEPTH = 4; ///< Branching levels expanded at most
+
+    ThreadPool &pool_; ///< Pool running the subtrees
+    EngineKind engineKind_; ///< Engine used for every subtree
+    std::vector<std::unique_ptr<SolverEngine> > engines_; ///< One engine per pool worker
+    std::atomic<bool> stop_{false}; ///< Sibling cancellation flag of the running call
+    const std::atomic<bool> *cancel_{nullptr}; ///< External cancellation flag (nullptr = never)
+    SolveStats stats_; ///< Statistics summed over all subtrees of the last call
+    bool profile_{false}; ///< Engines collect the detailed counters
+
+    std::vector<SudokuBoard> subtrees_; ///< Output of split(), reused between calls
+    std::vector<SudokuBoard> frontier_; ///< split() scratch level, reused between calls
+
+    /**
+     * @brief Expand the top of the search tree into independent subtrees
+     * @param board Puzzle
+     * @details Fills subtrees_ with boards that have extra cells filled; their
+     *          solutions partition those of board
+     */
+    void split(const SudokuBoard &board);
+
+    /**
+     * @brief Search every subtree on the pool and wait for all of them
+     * @tparam Body Callable as body(SolverEngine &, SudokuBoard &)
+     * @param body Work for one subtree with the calling worker's engine; sets stop_ to cancel siblings
+     * @details One task per worker claims subtrees_ in order until none are left, so a
+     *          call queues pool-size tasks that capture a single pointer each. Subtrees
+     *          not yet claimed when stop_ is set are skipped. The waiting thread forwards
+     *          the external cancellation flag into stop_. Defined in the .cpp file,
+     *          which holds its only callers.
+     */
+    template<typename Body>
+    void runSubtrees(Body &body);
+
+public:
+    /**
+     * @brief Bind to a pool
+     * @param pool Pool to run subtrees on (must outlive the solver)
+     * @param engine Engine used for every subtree
+     */
+    explicit ParallelSolver(ThreadPool &pool, EngineKind engine = EngineKind::Propagation);
+
+    /// Select the engine used for subtrees
+    void setEngine(EngineKind engine);
+
+    /// Engine used for subtrees
+    [[nodiscard]] EngineKind engine() const { return engineKind_; }
+
+    /**
+     * @brief Attach a flag that aborts the whole parallel search
+     * @param token Flag set by another thread (nullptr = not cancellable)
+     */
+    void setCancelToken(const std::atomic<bool> *token) { cancel_ = token; }
+
+    /**
+     * @brief Collect the detailed SolveStats counters in every subtree
+     * @param enabled Profiling on or off (see SolverEngine::setProfiling())
+     * @note Phase times are summed over workers (CPU time, not wall time); the
+     *       root split counts as setup and maxDepth is measured below the split
+     */
+    void setProfiling(bool enabled) { profile_ = enabled; }
+
+    /**
+     * @brief Solve board in place using every pool worker
+     * @param board Puzzle (0 = empty); filled with the solution on success
+     * @return true if a solution was found (false if unsolvable or cancelled)
+     */
+    bool solve(SudokuBoard &board);
+
+    /**
+     * @brief Count solutions using every pool worker, stopping at limit
+     * @param board Puzzle (0 = empty); left unchanged
+     * @param limit Maximum number of solutions to look for
+     * @return Number of solutions found, at most limit
+     */
+    [[nodiscard]] std::uint64_t countSolutions(const SudokuBoard &board, std::uint64_t limit);
+
+    /// Statistics merged over all subtrees of the last call
+    [[nodiscard]] const SolveStats &stats() const { return stats_; }
+};
+
+#endif // PARALLEL_SOLVER_HPP
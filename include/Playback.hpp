@@ -0,0 +1,92 @@
+#ifndef PLAYBACK_HPP
+#define PLAYBACK_HPP
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include "SolverEngine.hpp"
+
+class Sudoku;
+class SudokuGrid;
+
+/**
+ * @class Playback
+ * @brief Animated solve of the puzzle on the grid, for any board size
+ * @details
+ *   - Owns the BasicStepStream the solver thread writes into and the
+ *     BasicTracePlayer the animation plays from, instantiated for one board size
+ *   - Lets MainWindow drive the animation without knowing the size at compile
+ *     time; it replaces the instance whenever the grid changes size
+ *   - Grid-facing calls redraw each touched cell once, whatever the batch size
+ */
+class Playback {
+public:
+    /// Destructor
+    virtual ~Playback() = default;
+
+    /**
+     * @brief Create the playback for a board size
+     * @param box Box side (2-5)
+     * @return Owning pointer to the playback
+     */
+    [[nodiscard]] static std::unique_ptr<Playback> create(int box);
+
+    /// Box side of the boards played
+    [[nodiscard]] virtual int boxSize() const = 0;
+
+    /**
+     * @brief Start over from the board on the grid (before the producer starts)
+     * @param grid Grid of boxSize(); its current values become the givens of the trace
+     * @param cancel Flag that aborts a producer waiting for space (see BasicStepStream::reset())
+     */
+    virtual void start(SudokuGrid &grid, const std::atomic<bool> *cancel) = 0;
+
+    /**
+     * @brief Solve the board passed to start() into the step stream (producer, worker thread)
+     * @param solver Solver reused by every 9x9 job; other sizes create an engine per job
+     * @param engine Search algorithm (Dlx falls back to Propagation on other sizes)
+     */
+    virtual void produce(Sudoku &solver, EngineKind engine) = 0;
+
+    /// Drop the trace
+    virtual void clear() = 0;
+
+    /// Move all steps queued by the producer into the trace
+    virtual void drain() = 0;
+
+    /// Producer is done; steps may still be queued
+    [[nodiscard]] virtual bool finished() const = 0;
+
+    /// Search result (meaningful once finished())
+    [[nodiscard]] virtual bool solved() const = 0;
+
+    /// Number of steps received so far
+    [[nodiscard]] virtual std::size_t size() const = 0;
+
+    /// Number of steps shown on the grid
+    [[nodiscard]] virtual std::size_t position() const = 0;
+
+    /**
+     * @brief Play a batch of steps
+     * @param count Steps to apply
+     * @param deadline Stop early once this time has passed
+     * @param grid Grid to redraw; each cell written by the batch is updated once
+     */
+    virtual void advance(std::size_t count, std::chrono::steady_clock::time_point deadline, SudokuGrid &grid) = 0;
+
+    /**
+     * @brief Jump to a step of the trace
+     * @param target Number of steps to show, clamped to size()
+     * @param grid Grid to show the state at target on
+     */
+    virtual void seek(std::size_t target, SudokuGrid &grid) = 0;
+
+    /**
+     * @brief Apply the step at position() (only if position() < size())
+     * @param grid Grid to apply the step to
+     */
+    virtual void stepForward(SudokuGrid &grid) = 0;
+};
+
+#endif // PLAYBACK_HPP
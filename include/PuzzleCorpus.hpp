@@ -0,0 +1,183 @@
+#ifndef PUZZLE_CORPUS_HPP
+#define PUZZLE_CORPUS_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <optional>
+#include <span>
+#include <string>
+#include <vector>
+#include "DifficultyRater.hpp"
+#include "SudokuBoard.hpp"
+
+/**
+ * @class PuzzleCorpus
+ * @brief Read-only, memory-mapped binary puzzle collection
+ * @details File layout (all integers little-endian):
+ *   - Header, HEADER_SIZE bytes: magic "SDKCORP\0", version, record size, record
+ *     count, flags (FLAG_UNIQUE, FLAG_RATED), puzzles per Difficulty bucket and the
+ *     offset of the bucket index; the rest is zero
+ *   - count records of RECORD_SIZE bytes: cell 2k in the low nibble of byte k, cell
+ *     2k + 1 in the high nibble; the high nibble of the last byte holds the
+ *     puzzle's Difficulty (UNRATED if unknown)
+ *   - Rated files only: the bucket index, uint32 record numbers grouped by bucket
+ *     (Easy first), each group in file order
+ *
+ *   open() maps the file and validates the header; nothing is read or copied until
+ *   a record is asked for, so a file of millions of puzzles opens instantly and
+ *   the OS pages in only what is touched. at() unpacks one record (41 bytes).
+ */
+class PuzzleCorpus {
+public:
+    static constexpr std::size_t HEADER_SIZE = 128; ///< Bytes before the first record
+    static constexpr std::size_t RECORD_SIZE = 41; ///< 81 cells at 4 bits, plus the difficulty nibble
+    static constexpr std::uint32_t VERSION = 1; ///< Format version written by CorpusWriter
+    static constexpr std::uint32_t FLAG_UNIQUE = 1; ///< Every puzzle was checked to have one solution
+    static constexpr std::uint32_t FLAG_RATED = 2; ///< Every puzzle carries a difficulty, bucket index present
+    static constexpr std::uint8_t UNRATED = 0xF; ///< Difficulty nibble of unrated records
+    static constexpr std::array<char, 8> MAGIC = {'S', 'D', 'K', 'C', 'O', 'R', 'P', '\0'}; ///< File signature
+
+    /// One packed record
+    using Record = std::array<std::uint8_t, RECORD_SIZE>;
+
+    /**
+     * @struct Header
+     * @brief Decoded file header
+     */
+    struct Header {
+        std::uint32_t version{VERSION}; ///< Format version
+        std::uint64_t count{0}; ///< Number of records
+        std::uint32_t flags{0}; ///< FLAG_* bits
+        std::array<std::uint64_t, DIFFICULTY_COUNT> buckets{}; ///< Records per difficulty (rated files)
+        std::uint64_t indexOffset{0}; ///< File offset of the bucket index (0 = none)
+    };
+
+private:
+    const std::uint8_t *data_{nullptr}; ///< Start of the mapping (null when closed)
+    std::size_t length_{0}; ///< Bytes mapped
+    Header header_; ///< Decoded header
+    std::array<std::uint64_t, DIFFICULTY_COUNT> bucketStart_{}; ///< First index entry per bucket
+#ifdef _WIN32
+    void *mapping_{nullptr}; ///< File mapping handle
+#endif
+
+public:
+    PuzzleCorpus() = default;
+    ~PuzzleCorpus();
+    PuzzleCorpus(const PuzzleCorpus &) = delete;
+    PuzzleCorpus &operator=(const PuzzleCorpus &) = delete;
+    PuzzleCorpus(PuzzleCorpus &&other) noexcept;
+    PuzzleCorpus &operator=(PuzzleCorpus &&other) noexcept;
+
+    /**
+     * @brief Map a corpus file (closes the current one first)
+     * @param path File name
+     * @param error Receives the reason on failure (optional)
+     * @return true if the file is mapped and its header, size and index are consistent
+     */
+    bool open(const std::string &path, std::string *error = nullptr);
+
+    /// Unmap the file
+    void close();
+
+    [[nodiscard]] bool isOpen() const { return data_ != nullptr; }
+    [[nodiscard]] std::size_t size() const { return static_cast<std::size_t>(header_.count); }
+    [[nodiscard]] const Header &header() const { return header_; }
+    [[nodiscard]] bool unique() const { return (header_.flags & FLAG_UNIQUE) != 0; }
+    [[nodiscard]] bool rated() const { return (header_.flags & FLAG_RATED) != 0; }
+
+    /// Packed bytes of record index (a view into the mapping, no copy)
+    [[nodiscard]] std::span<const std::uint8_t, RECORD_SIZE> record(std::size_t index) const {
+        return std::span<const std::uint8_t, RECORD_SIZE>(data_ + HEADER_SIZE + index * RECORD_SIZE, RECORD_SIZE);
+    }
+
+    /**
+     * @brief Puzzle index (index < size())
+     * @note Cells hold the raw nibbles, so a damaged record may yield values 10-15;
+     *       check valid(index) before solving puzzles from an untrusted file
+     */
+    [[nodiscard]] SudokuBoard at(std::size_t index) const { return unpack(record(index)); }
+
+    /// Every cell of record index is a digit 0-9 (open() only validates the header)
+    [[nodiscard]] bool valid(std::size_t index) const { return isValid(record(index)); }
+
+    /// Difficulty of puzzle index, nullopt if unrated
+    [[nodiscard]] std::optional<Difficulty> difficulty(std::size_t index) const;
+
+    /// Number of puzzles in a bucket (0 unless rated())
+    [[nodiscard]] std::size_t bucketSize(Difficulty difficulty) const;
+
+    /**
+     * @brief Record number of the n-th puzzle of a bucket
+     * @param difficulty Bucket (rated() only)
+     * @param n Position in the bucket, < bucketSize(difficulty)
+     * @return Index for at(), nullopt if n is out of range or the index entry
+     *         does not name a record (damaged file)
+     */
+    [[nodiscard]] std::optional<std::size_t> bucketAt(Difficulty difficulty, std::size_t n) const;
+
+    /**
+     * @brief Pack a board into a record
+     * @param board Puzzle (cells 0-9)
+     * @param difficulty Difficulty nibble (UNRATED if unknown)
+     * @return Packed record
+     */
+    [[nodiscard]] static Record pack(const SudokuBoard &board, std::uint8_t difficulty = UNRATED);
+
+    /// Unpack a record (cell values are the raw nibbles, see isValid())
+    [[nodiscard]] static SudokuBoard unpack(std::span<const std::uint8_t, RECORD_SIZE> record);
+
+    /// Every cell nibble of a record is a digit 0-9 (the difficulty nibble is not checked)
+    [[nodiscard]] static bool isValid(std::span<const std::uint8_t, RECORD_SIZE> record);
+
+    /// Whether path starts with the corpus magic (cheap format sniffing)
+    [[nodiscard]] static bool isCorpus(const std::string &path);
+};
+
+/**
+ * @class CorpusWriter
+ * @brief Streams records into a new corpus file
+ * @details Records are appended as they come; finish() writes the bucket index (for
+ *          rated files) and the final header. Only the index (4 bytes per puzzle) is
+ *          kept in memory, so any number of puzzles can be converted.
+ */
+class CorpusWriter {
+    std::FILE *file_{nullptr}; ///< Output (null when closed)
+    std::uint64_t count_{0}; ///< Records written
+    std::array<std::vector<std::uint32_t>, DIFFICULTY_COUNT> buckets_; ///< Record numbers per difficulty
+    bool rated_{true}; ///< Every record so far has a difficulty
+    bool failed_{false}; ///< A write failed
+
+public:
+    CorpusWriter() = default;
+    ~CorpusWriter();
+    CorpusWriter(const CorpusWriter &) = delete;
+    CorpusWriter &operator=(const CorpusWriter &) = delete;
+
+    /**
+     * @brief Create the output file (placeholder header)
+     * @param path File name
+     * @return true on success
+     */
+    bool open(const std::string &path);
+
+    /**
+     * @brief Append a puzzle
+     * @param board Puzzle
+     * @param difficulty Its rating, if known; the file is rated only if all are
+     */
+    void add(const SudokuBoard &board, std::optional<Difficulty> difficulty = std::nullopt);
+
+    /**
+     * @brief Write the index and header, then close
+     * @param unique Whether every puzzle was checked to have one solution (FLAG_UNIQUE)
+     * @return true if every write succeeded
+     */
+    bool finish(bool unique);
+
+    [[nodiscard]] std::uint64_t count() const { return count_; }
+};
+
+#endif // PUZZLE_CORPUS_HPP
@@ -0,0 +1,117 @@
+#ifndef PUZZLE_GENERATOR_HPP
+#define PUZZLE_GENERATOR_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <vector>
+#include "DifficultyRater.hpp"
+#include "SolverEngine.hpp"
+#include "ThreadPool.hpp"
+
+/**
+ * @class PuzzleGenerator
+ * @brief Random puzzles with exactly one solution
+ * @details
+ *   - Solved grid: the three diagonal boxes share no row, column or box, so they
+ *     are filled with shuffled digits and the propagation engine completes the rest
+ *   - Clues are then removed in random order; a removal is kept only if the puzzle
+ *     stays unique. The solution is known, so uniqueness means no other candidate
+ *     digit of the removed cell completes the grid: a cell still forced by the clues
+ *     (single candidate) needs no search at all, otherwise each alternative is
+ *     solved and the clue goes back as soon as one of them succeeds
+ *   - Stops at the target clue count, or earlier when no clue can be removed
+ *     (the puzzle is minimal)
+ *   - Difficulty targets dig to a clue count that suits the bucket and retry until
+ *     the DifficultyRater agrees
+ *   - One instance per thread; generateMany() fills a batch on a ThreadPool
+ */
+class PuzzleGenerator {
+public:
+    static constexpr int MIN_CLUES = 17; ///< No 9x9 puzzle with fewer clues is unique
+    static constexpr int DEFAULT_CLUES = 26; ///< Clue target of the GUI and the command-line tool
+    static constexpr int EASY_CLUES = 30; ///< Clue target for Easy puzzles (harder buckets dig to MIN_CLUES)
+    static constexpr int MAX_ATTEMPTS = 1000; ///< Puzzles tried per difficulty target
+    static constexpr std::size_t BLOCK = 64; ///< Puzzles per generateMany() task
+
+private:
+    std::mt19937_64 rng_; ///< Source of all randomness (deterministic per seed)
+    std::unique_ptr<SolverEngine> engine_; ///< Completes grids and tries alternatives
+    SudokuBoard trial_; ///< Scratch board for alternative digits
+    DifficultyRater rater_; ///< Grades puzzles for difficulty targets
+
+    /**
+     * @brief Remove one clue if the puzzle stays unique
+     * @param puzzle Unique puzzle; the clue is cleared on success and kept otherwise
+     * @param cell Cell index of the clue
+     * @return true if the clue was removed
+     */
+    bool tryRemove(SudokuBoard &puzzle, int cell);
+
+public:
+    /**
+     * @brief Create a generator
+     * @param seed Seed; equal seeds give equal puzzle sequences
+     */
+    explicit PuzzleGenerator(std::uint64_t seed = std::random_device{}());
+
+    /**
+     * @brief Random completely filled valid grid
+     * @return Solved board
+     */
+    [[nodiscard]] SudokuBoard solvedGrid();
+
+    /**
+     * @brief Random puzzle with a unique solution
+     * @param clues Target clue count, clamped to [MIN_CLUES, 81]; low targets may
+     *              not be reached, the puzzle then has as few clues as it can
+     * @param solution Receives the solution (optional)
+     * @return Puzzle (0 = empty)
+     */
+    [[nodiscard]] SudokuBoard generate(int clues = DEFAULT_CLUES, SudokuBoard *solution = nullptr);
+
+    /**
+     * @brief Random puzzle with a unique solution and a given difficulty
+     * @param difficulty Target bucket
+     * @param solution Receives the solution (optional)
+     * @param rating Receives the puzzle's rating (optional)
+     * @return First puzzle rated in the bucket; the last one tried if none of
+     *         MAX_ATTEMPTS is (never seen in practice, Hard is the rarest at ~7%)
+     */
+    [[nodiscard]] SudokuBoard generate(Difficulty difficulty, SudokuBoard *solution = nullptr,
+                                       Rating *rating = nullptr);
+
+    /**
+     * @brief Generate many puzzles on a pool
+     * @param pool Workers (must not be called from one of them)
+     * @param count Number of puzzles
+     * @param clues Target clue count (see generate())
+     * @param seed Seed of the batch
+     * @return count puzzles; blocks of BLOCK puzzles get their own generator seeded
+     *         from (seed, block index), so the result does not depend on the pool size
+     */
+    [[nodiscard]] static std::vector<SudokuBoard> generateMany(ThreadPool &pool, std::size_t count, int clues,
+                                                               std::uint64_t seed);
+
+    /**
+     * @brief Generate many puzzles of one difficulty on a pool
+     * @param pool Workers (must not be called from one of them)
+     * @param count Number of puzzles
+     * @param difficulty Target bucket (see generate(Difficulty))
+     * @param seed Seed of the batch
+     * @return count puzzles, independent of the pool size like the clue-count overload
+     */
+    [[nodiscard]] static std::vector<SudokuBoard> generateMany(ThreadPool &pool, std::size_t count,
+                                                               Difficulty difficulty, std::uint64_t seed);
+
+    /**
+     * @brief Derive an independent seed
+     * @param seed Base seed
+     * @param stream Stream index (block, round, ...)
+     * @return Well-mixed seed (SplitMix64 finaliser)
+     */
+    [[nodiscard]] static std::uint64_t streamSeed(std::uint64_t seed, std::uint64_t stream);
+};
+
+#endif // PUZZLE_GENERATOR_HPP
@@ -0,0 +1,109 @@
+#ifndef SOLUTION_CACHE_HPP
+#define SOLUTION_CACHE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+#include "PuzzleCorpus.hpp"
+#include "SudokuBoard.hpp"
+
+/**
+ * @class SolutionCache
+ * @brief Bounded least-recently-used map from canonical puzzles to their solutions
+ * @details
+ *   - Keys and solutions are canonical boards (see Canonicalizer) packed into
+ *     41-byte corpus records, so every relabelled, transposed or row/band-permuted
+ *     copy of a puzzle shares one entry
+ *   - Fixed slot array with an intrusive recency list and an open-addressing index
+ *     (linear probing, backward-shift deletion): lookups, inserts and evictions are
+ *     O(1) and never allocate after construction
+ *   - Thread-safe (one mutex); batch workers can share a cache
+ *   - save()/load() persist the entries in recency order (file magic "SDKCACHE")
+ */
+class SolutionCache {
+public:
+    static constexpr std::size_t DEFAULT_CAPACITY = 1U << 16; ///< Entries kept by default (~6 MB)
+    static constexpr std::uint32_t VERSION = 1; ///< Cache file format version
+
+private:
+    using Record = PuzzleCorpus::Record;
+    static constexpr std::uint32_t NONE = UINT32_MAX; ///< Empty index slot / list end
+
+    /**
+     * @struct Entry
+     * @brief One cached puzzle
+     */
+    struct Entry {
+        Record key{}; ///< Packed canonical puzzle
+        Record solution{}; ///< Packed canonical solution
+        std::uint64_t hash{0}; ///< Hash of key (kept for probing and deletion)
+        std::uint32_t prev{NONE}; ///< More recently used neighbour
+        std::uint32_t next{NONE}; ///< Less recently used neighbour
+    };
+
+    mutable std::mutex mutex_; ///< Guards everything below
+    std::vector<Entry> entries_; ///< Slots, the first size_ in use
+    std::vector<std::uint32_t> index_; ///< Open-addressing table of slot numbers
+    std::size_t size_{0}; ///< Entries in use
+    std::uint32_t newest_{NONE}; ///< Most recently used slot
+    std::uint32_t oldest_{NONE}; ///< Least recently used slot (evicted first)
+    std::uint64_t hits_{0}; ///< Successful lookups
+    std::uint64_t misses_{0}; ///< Failed lookups
+
+    [[nodiscard]] std::size_t locate(const Record &key, std::uint64_t hash) const;
+    void unlink(std::uint32_t slot);
+    void pushFront(std::uint32_t slot);
+    void eraseIndex(std::size_t position);
+    void insertLocked(const Record &key, const Record &solution);
+
+public:
+    /**
+     * @brief Create an empty cache
+     * @param capacity Maximum number of entries (at least 1)
+     */
+    explicit SolutionCache(std::size_t capacity = DEFAULT_CAPACITY);
+
+    /**
+     * @brief Look up a canonical puzzle and mark it most recently used
+     * @param canonical Canonical puzzle
+     * @return Its canonical solution, if cached
+     */
+    [[nodiscard]] std::optional<SudokuBoard> find(const SudokuBoard &canonical);
+
+    /**
+     * @brief Store a solution, evicting the least recently used entry when full
+     * @param canonical Canonical puzzle
+     * @param solution Solution in the same (canonical) frame
+     */
+    void insert(const SudokuBoard &canonical, const SudokuBoard &solution);
+
+    /// Remove every entry (statistics are kept)
+    void clear();
+
+    [[nodiscard]] std::size_t size() const;
+    [[nodiscard]] std::size_t capacity() const { return entries_.size(); }
+    [[nodiscard]] std::uint64_t hits() const;
+    [[nodiscard]] std::uint64_t misses() const;
+
+    /**
+     * @brief Write all entries to a file, least recently used first
+     * @param path File name
+     * @return true on success
+     */
+    bool save(const std::string &path) const;
+
+    /**
+     * @brief Replace the contents with a saved cache
+     * @param path File name
+     * @return true if the file was read completely; a missing or foreign file leaves
+     *         the cache empty. Files larger than the capacity keep their newest entries
+     * @details Records whose solution is not a complete valid grid agreeing with the
+     *          givens of its key (corrupt files) are skipped
+     */
+    bool load(const std::string &path);
+};
+
+#endif // SOLUTION_CACHE_HPP
@@ -0,0 +1,301 @@
+#ifndef SOLVER_ENGINE_HPP
+#define SOLVER_ENGINE_HPP
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+#include "SudokuBoard.hpp"
+
+/**
+ * @enum StepKind
+ * @brief How the value of a SolveStep was obtained
+ */
+enum class StepKind : std::uint8_t {
+    Guess, ///< Placed (or removed) by the backtracking search
+    Deduced ///< Forced by constraint propagation (naked/hidden single)
+};
+
+/**
+ * @struct SolveStep
+ * @brief Represents a single step in the solving process
+ * @details Used for animation and visualization of the solving algorithm
+ */
+struct SolveStep {
+    int row; ///< Row index (0-8 on 9x9 boards)
+    int col; ///< Column index (0-8 on 9x9 boards)
+    int value; ///< Value placed (1-9 on 9x9 boards) or 0 for removal
+    StepKind kind{StepKind::Guess}; ///< Search guess or propagation deduction
+};
+
+/**
+ * @class StepSink
+ * @brief Receiver of the SolveStep trace, fed while the engine searches
+ * @details Lets the trace be consumed incrementally (see StepStream) instead of
+ *          being recorded in full before anything looks at it
+ */
+class StepSink {
+public:
+    /// Destructor
+    virtual ~StepSink() = default;
+
+    /**
+     * @brief Receive the next step
+     * @param step Placement, removal or deduction, in search order
+     */
+    virtual void push(const SolveStep &step) = 0;
+};
+
+/**
+ * @class VectorStepSink
+ * @brief Records the whole trace into a vector
+ */
+class VectorStepSink final : public StepSink {
+    std::vector<SolveStep> &steps_; ///< Destination
+
+public:
+    /// Append to steps
+    explicit VectorStepSink(std::vector<SolveStep> &steps) : steps_(steps) {
+    }
+
+    void push(const SolveStep &step) override { steps_.push_back(step); }
+};
+
+/**
+ * @enum EngineKind
+ * @brief Search algorithm used by Sudoku::solve() and Sudoku::solveWithSteps()
+ */
+enum class EngineKind {
+    Naive, ///< Plain backtracking, rescans row/column/box for every candidate
+    Bitmask, ///< Backtracking over incrementally maintained row/column/box masks
+    Mrv, ///< Bitmask search branching on the most-constrained empty cell
+    Propagation, ///< MRV search with naked/hidden single propagation after every guess (default)
+    Dlx ///< Dancing Links exact-cover search (see DlxSolver)
+};
+
+/**
+ * @struct SolveStats
+ * @brief Search statistics of the last solve
+ * @details Counted identically by every engine: one node per guess placed,
+ *          one backtrack per guess undone (Guess steps in the trace).
+ *          The remaining counters are only collected by solve() while profiling
+ *          is enabled (SolverEngine::setProfiling()) and stay zero otherwise.
+ */
+struct SolveStats {
+    std::uint64_t nodes{0}; ///< Guesses placed by the search
+    std::uint64_t backtracks{0}; ///< Guesses undone
+
+    std::uint64_t candidateTests{0}; ///< isValid() calls, candidate mask evaluations or DLX column sizes compared
+    std::uint64_t deductions{0}; ///< Cells forced by propagation (naked/hidden singles)
+    int maxDepth{0}; ///< Deepest guess nesting reached
+    std::chrono::nanoseconds setupTime{0}; ///< Building masks or covering the givens
+    std::chrono::nanoseconds searchTime{0}; ///< Search, propagation included
+    std::chrono::nanoseconds propagationTime{0}; ///< Part of searchTime spent propagating
+
+    /**
+     * @brief Add the statistics of another (sub)search
+     * @param other Statistics to merge; counters and times add up, depth takes the maximum
+     */
+    void merge(const SolveStats &other) {
+        nodes += other.nodes;
+        backtracks += other.backtracks;
+        candidateTests += other.candidateTests;
+        deductions += other.deductions;
+        maxDepth = std::max(maxDepth, other.maxDepth);
+        setupTime += other.setupTime;
+        searchTime += other.searchTime;
+        propagationTime += other.propagationTime;
+    }
+};
+
+/**
+ * @class BasicSolverEngine
+ * @brief Abstract search algorithm for one board size
+ * @tparam Box Box side of the boards solved (see BasicBoard)
+ * @details
+ *   - Engines are stateless between solves apart from reusable scratch buffers
+ *   - Every engine produces the same SolveStep trace format and SolveStats
+ *   - Obtain instances through SolverRegistry
+ */
+template<int Box>
+class BasicSolverEngine {
+public:
+    using Board = BasicBoard<Box>; ///< Board type solved by this engine
+
+protected:
+    SolveStats stats_; ///< Statistics of the last solve
+    const std::atomic<bool> *cancel_{nullptr}; ///< Cooperative cancellation flag (nullptr = never)
+    bool profile_{false}; ///< Collect the detailed SolveStats counters
+    int guessDepth_{0}; ///< Current guess nesting (profiled solves only)
+
+    /// Cancellation requested - searches check this at every node and unwind
+    [[nodiscard]] bool cancelled() const {
+        return cancel_ != nullptr && cancel_->load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Run the search instantiation matching this solve
+     * @param steps Step sink (nullptr = fast path)
+     * @param search Generic callable taking std::bool_constant<RecordSteps> and
+     *               std::bool_constant<Profile>; both flags are compile-time inside
+     * @return Result of search
+     * @details Unprofiled instantiations contain no instrumentation code at all
+     */
+    template<typename Search>
+    bool dispatch(StepSink *steps, Search &&search) {
+        if (profile_)
+            return steps != nullptr ? search(std::true_type{}, std::true_type{})
+                                    : search(std::false_type{}, std::true_type{});
+        return steps != nullptr ? search(std::true_type{}, std::false_type{})
+                                : search(std::false_type{}, std::false_type{});
+    }
+
+    /// Add n to a profiling counter (no-op unless Profile)
+    template<bool Profile>
+    static void tally(std::uint64_t &counter, std::uint64_t n = 1) {
+        if constexpr (Profile) counter += n;
+    }
+
+    /// Enter one guess level and track the maximum depth (no-op unless Profile)
+    template<bool Profile>
+    void descend() {
+        if constexpr (Profile) stats_.maxDepth = std::max(stats_.maxDepth, ++guessDepth_);
+    }
+
+    /// Leave a guess level after backtracking (no-op unless Profile)
+    template<bool Profile>
+    void ascend() {
+        if constexpr (Profile) --guessDepth_;
+    }
+
+    /**
+     * @brief Call f and add its duration to a phase time (plain call unless Profile)
+     * @param phase Phase counter in stats_
+     * @param f Work to time
+     * @return Result of f
+     */
+    template<bool Profile, typename F>
+    static auto timed(std::chrono::nanoseconds &phase, F &&f) {
+        if constexpr (Profile) {
+            const auto start = std::chrono::steady_clock::now();
+            auto result = f();
+            phase += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+            return result;
+        } else {
+            return f();
+        }
+    }
+
+public:
+    /// Destructor
+    virtual ~BasicSolverEngine() = default;
+
+    /// Engine identifier
+    [[nodiscard]] virtual EngineKind kind() const = 0;
+
+    /**
+     * @brief Solve board in place
+     * @param board Puzzle (0 = empty); filled with the solution on success
+     * @param steps Optional step sink for placements and removals (nullptr = fast path)
+     * @return true if puzzle has solution, false if unsolvable
+     */
+    virtual bool solve(Board &board, StepSink *steps) = 0;
+
+    /**
+     * @brief Count solutions, stopping as soon as limit of them are found
+     * @param board Puzzle (0 = empty); left unchanged
+     * @param limit Maximum number of solutions to look for (2 is enough for a uniqueness check)
+     * @return Number of solutions found, at most limit
+     * @note The default implementation runs the propagation search, so engines
+     *       without a counting mode of their own still use the fast candidate machinery
+     */
+    [[nodiscard]] virtual std::uint64_t countSolutions(const Board &board, std::uint64_t limit);
+
+    /// Statistics of the last solve
+    [[nodiscard]] const SolveStats &stats() const { return stats_; }
+
+    /**
+     * @brief Attach a cancellation flag polled by the search
+     * @param token Flag set by another thread to abort (nullptr = not cancellable)
+     * @note A cancelled solve() returns false and a cancelled countSolutions()
+     *       returns the partial count; the caller tells the cases apart via the flag
+     */
+    void setCancelToken(const std::atomic<bool> *token) { cancel_ = token; }
+
+    /**
+     * @brief Collect candidate tests, deductions, depth and phase times in solve()
+     * @param enabled Use the instrumented search; off runs code without any counters
+     */
+    void setProfiling(bool enabled) { profile_ = enabled; }
+
+    /// Detailed counters are collected
+    [[nodiscard]] bool profiling() const { return profile_; }
+};
+
+/// Engine for the classic 9x9 board (Sudoku, ParallelSolver and the registry table)
+using SolverEngine = BasicSolverEngine<3>;
+
+extern template class BasicSolverEngine<2>;
+extern template class BasicSolverEngine<3>;
+extern template class BasicSolverEngine<4>;
+extern template class BasicSolverEngine<5>;
+
+/**
+ * @class SolverRegistry
+ * @brief Table of available engines with their identifiers and factories
+ * @details The table lists the 9x9 engines; create<Box>() builds the same search
+ *          algorithms for the other board sizes
+ */
+class SolverRegistry {
+public:
+    /**
+     * @struct Entry
+     * @brief One registered engine
+     */
+    struct Entry {
+        EngineKind kind; ///< Engine identifier
+        std::string_view id; ///< Short name for command lines ("mrv", "dlx", ...)
+        std::string_view label; ///< Human-readable name for the GUI
+        std::unique_ptr<SolverEngine> (*create)(); ///< Factory
+    };
+
+    /// All registered engines, in EngineKind order
+    [[nodiscard]] static const std::array<Entry, 5> &engines();
+
+    /**
+     * @brief Registry entry of an engine
+     * @param kind Engine identifier
+     * @return Matching entry
+     */
+    [[nodiscard]] static const Entry &entry(EngineKind kind);
+
+    /**
+     * @brief Look up an engine by its short name
+     * @param id Short name ("naive", "bitmask", "mrv", "propagation", "dlx")
+     * @return Matching entry, or nullptr if unknown
+     */
+    [[nodiscard]] static const Entry *find(std::string_view id);
+
+    /**
+     * @brief Create a new engine instance
+     * @param kind Engine identifier
+     * @return Owning pointer to the engine
+     */
+    [[nodiscard]] static std::unique_ptr<SolverEngine> create(EngineKind kind);
+
+    /**
+     * @brief Create a new engine instance for another board size
+     * @tparam Box Box side (2, 3, 4 or 5)
+     * @param kind Engine identifier; Dlx is 9x9-only and falls back to Propagation
+     * @return Owning pointer to the engine
+     */
+    template<int Box>
+    [[nodiscard]] static std::unique_ptr<BasicSolverEngine<Box> > create(EngineKind kind);
+};
+
+#endif // SOLVER_ENGINE_HPP
@@ -0,0 +1,84 @@
+#ifndef SPSC_RING_HPP
+#define SPSC_RING_HPP
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+
+/**
+ * @class SpscRing
+ * @brief Bounded lock-free single-producer/single-consumer queue
+ * @tparam T Element type (copied in and out)
+ * @tparam Capacity Number of slots, power of two
+ * @details
+ *   - head_ is written only by the consumer, tail_ only by the producer;
+ *     they sit on separate cache lines so the two sides do not false-share
+ *   - Each side caches the other side's index and reloads it (acquire) only
+ *     when the ring looks full or empty
+ *   - Indices run freely and are masked on access, so all Capacity slots are usable
+ */
+template<typename T, std::size_t Capacity>
+class SpscRing {
+    static_assert(std::has_single_bit(Capacity), "Capacity must be a power of two");
+
+    static constexpr std::size_t MASK = Capacity - 1; ///< Index mask
+    static constexpr std::size_t CACHE_LINE = 64; ///< Padding between producer and consumer state
+
+    alignas(CACHE_LINE) std::atomic<std::size_t> head_{0}; ///< Next slot to read (consumer)
+    std::size_t tailCache_{0}; ///< Consumer's last view of tail_
+    alignas(CACHE_LINE) std::atomic<std::size_t> tail_{0}; ///< Next slot to write (producer)
+    std::size_t headCache_{0}; ///< Producer's last view of head_
+    alignas(CACHE_LINE) std::array<T, Capacity> slots_{}; ///< Storage
+
+public:
+    /**
+     * @brief Append an element (producer side)
+     * @param value Element to copy in
+     * @return false if the ring is full
+     */
+    bool tryPush(const T &value) {
+        const std::size_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail - headCache_ == Capacity) {
+            headCache_ = head_.load(std::memory_order_acquire);
+            if (tail - headCache_ == Capacity) return false;
+        }
+        slots_[tail & MASK] = value;
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Remove the oldest element (consumer side)
+     * @param value Receives the element
+     * @return false if the ring is empty
+     */
+    bool tryPop(T &value) {
+        const std::size_t head = head_.load(std::memory_order_relaxed);
+        if (head == tailCache_) {
+            tailCache_ = tail_.load(std::memory_order_acquire);
+            if (head == tailCache_) return false;
+        }
+        value = slots_[head & MASK];
+        head_.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    /// Number of queued elements (a snapshot when called concurrently)
+    [[nodiscard]] std::size_t size() const {
+        return tail_.load(std::memory_order_acquire) - head_.load(std::memory_order_acquire);
+    }
+
+    /// Number of slots
+    [[nodiscard]] static constexpr std::size_t capacity() { return Capacity; }
+
+    /// Drop all elements - only while neither side is running
+    void clear() {
+        head_.store(0, std::memory_order_relaxed);
+        tail_.store(0, std::memory_order_relaxed);
+        headCache_ = 0;
+        tailCache_ = 0;
+    }
+};
+
+#endif // SPSC_RING_HPP
@@ -0,0 +1,84 @@
+#ifndef STEP_STREAM_HPP
+#define STEP_STREAM_HPP
+
+#include <atomic>
+#include <cstddef>
+#include "CompactTrace.hpp"
+#include "SpscRing.hpp"
+
+/**
+ * @class BasicStepStream
+ * @brief Bounded step channel from a solver thread to the animation
+ * @tparam Box Box side of the solved board (see BasicBoard)
+ * @details
+ *   - The solver thread is the producer (it runs the engine with this stream as
+ *     its StepSink); the display is the consumer, popping steps as it draws them
+ *   - Memory is fixed at CAPACITY steps however long the trace gets; the producer
+ *     sleeps while the ring is full, i.e. it runs at most CAPACITY steps ahead
+ *   - Steps travel as BasicCompactTrace codes (32 KB ring up to 16x16, 64 KB for 25x25)
+ *   - A raised cancellation token releases a waiting producer; the engine then
+ *     sees the same token at its next node and unwinds
+ */
+template<int Box>
+class BasicStepStream final : public StepSink {
+    using Trace = BasicCompactTrace<Box>; ///< Step encoding
+
+public:
+    static constexpr std::size_t CAPACITY = std::size_t{1} << 14; ///< Steps buffered ahead of the display
+
+private:
+    SpscRing<typename Trace::Code, CAPACITY> ring_; ///< Pending steps, encoded
+    const std::atomic<bool> *cancel_{nullptr}; ///< Releases a producer blocked on a full ring
+    std::atomic<bool> finished_{false}; ///< Producer is done; no more pushes
+    std::atomic<bool> solved_{false}; ///< Search result (valid once finished_)
+
+public:
+    /**
+     * @brief Prepare for a new producer - only while no producer is running
+     * @param cancel Flag that aborts a producer waiting for space (nullptr = wait forever)
+     */
+    void reset(const std::atomic<bool> *cancel);
+
+    /**
+     * @brief Queue a step (producer), waiting while the ring is full
+     * @param step Step to queue; dropped if the stream is cancelled while waiting
+     */
+    void push(const SolveStep &step) override;
+
+    /**
+     * @brief Mark the end of the trace (producer)
+     * @param solved Search result
+     */
+    void finish(bool solved);
+
+    /**
+     * @brief Take the next step (consumer)
+     * @param step Receives the step
+     * @return false if no step is available right now
+     */
+    bool tryPop(SolveStep &step) {
+        typename Trace::Code code = 0;
+        if (!ring_.tryPop(code)) return false;
+        step = Trace::decode(code);
+        return true;
+    }
+
+    /// Producer called finish(); remaining steps can still be popped
+    [[nodiscard]] bool finished() const { return finished_.load(std::memory_order_acquire); }
+
+    /// Search result (meaningful once finished())
+    [[nodiscard]] bool solved() const { return solved_.load(std::memory_order_relaxed); }
+
+    /// Steps queued but not yet popped (snapshot)
+    [[nodiscard]] std::size_t pending() const { return ring_.size(); }
+};
+
+/// Step channel of a 9x9 solve
+using StepStream = BasicStepStream<3>;
+
+extern template class BasicStepStream<2>;
+extern template class BasicStepStream<3>;
+extern template class BasicStepStream<4>;
+extern template class BasicStepStream<5>;
+
+#endif // STEP_STREAM_HPP
@@ -1,67 +1,53 @@
 #ifndef SUDOKU_HPP
 #define SUDOKU_HPP
 
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
 #include <vector>
+#include "Canonicalizer.hpp"
+#include "SudokuBoard.hpp"
+#include "SolverEngine.hpp"
 
-/**
- * @struct SolveStep
- * @brief Represents a single step in the solving process
- * @details Used for animation and visualization of the solving algorithm
- */
-struct SolveStep {
-    int row; ///< Row index (0-8)
-    int col; ///< Column index (0-8)
-    int value; ///< Value placed (1-9) or 0 for removal
-};
+class SolutionCache;
 
 /**
  * @class Sudoku
- * @brief Core Sudoku solver using backtracking algorithm
+ * @brief Sudoku puzzle with a pluggable solver engine
  * @details
- *   - Implements efficient backtracking algorithm
+ *   - Holds the board and the given-cell mask
+ *   - Delegates solving to a SolverEngine picked with setEngine()
+ *     (see SolverRegistry for the available engines)
  *   - Supports both fast solving and step-by-step solving
  *   - Validates moves according to Sudoku rules
- *   - Time complexity: O(9^k) where k is number of empty cells
+ *   - Default engine is Propagation (as in the GUI, sudoku_batch and
+ *     ParallelSolver): mask-based MRV search with singles propagated before
+ *     every branch
+ *   - Optional SolutionCache in front of solve(): boards are canonicalised, so a
+ *     puzzle seen before under any symmetry is answered without a search
  */
 class Sudoku {
+public:
     // Type aliases for cleaner code
-    using Board = std::vector<std::vector<int> >;
-    using GivenMask = std::vector<std::vector<bool> >;
-
-    static constexpr int SIZE = 9; ///< Grid size (9x9)
-    static constexpr int GRID_SIZE = 3; ///< Sub-grid size (3x3)
+    using Board = SudokuBoard; ///< Flat 81-byte board
 
+private:
     Board board_; ///< Current board state
     GivenMask given_; ///< Marks initially given cells
-
-    /**
-     * @brief Recursive helper function for solving with step tracking
-     * @param steps Vector to store solving steps
-     * @return true if puzzle is solvable, false otherwise
-     */
-    bool solveRecursive(std::vector<SolveStep> &steps);
-
-    /**
-     * @brief Safe array access with bounds checking (inline for optimization)
-     * @param board The board to access
-     * @param row Row index
-     * @param col Column index
-     * @return Cell value
-     */
-    static int getFromBoard(const Board &board, int row, int col) {
-        return board[static_cast<size_t>(row)][static_cast<size_t>(col)];
-    }
-
-    /**
-     * @brief Safe array set with bounds checking (inline for optimization)
-     * @param board The board to modify
-     * @param row Row index
-     * @param col Column index
-     * @param val Value to set
-     */
-    static void setToBoard(Board &board, int row, int col, int val) {
-        board[static_cast<size_t>(row)][static_cast<size_t>(col)] = val;
-    }
+    EngineKind engineKind_{EngineKind::Propagation}; ///< Selected search algorithm
+    std::unique_ptr<SolverEngine> engine_; ///< Engine instance, created on first solve
+    const std::atomic<bool> *cancel_{nullptr}; ///< Cancellation flag handed to the engine
+    bool profile_{false}; ///< Profiling flag handed to the engine
+    SolutionCache *cache_{nullptr}; ///< Solution cache consulted by solve() (not owned)
+    std::unique_ptr<Canonicalizer> canonicalizer_; ///< Created on the first cached solve
+    Board canonical_; ///< Canonical form of the board of the last cache miss
+    BoardTransform transform_; ///< Maps that board onto canonical_
+    bool keyed_{false}; ///< canonical_/transform_ describe the pending miss
+    bool cacheHit_{false}; ///< Last solve was answered by the cache
+
+    /// Engine instance for engineKind_ (created lazily and reused across solves)
+    SolverEngine &activeEngine();
 
 public:
     /// Default/example puzzle
@@ -70,11 +56,12 @@ public:
     /**
      * @brief Constructor with initial board
      * @param inputBoard Initial puzzle state (0 = empty cell)
+     * @note Nested-vector boards convert implicitly through SudokuBoard
      */
     explicit Sudoku(const Board &inputBoard = DEFAULT_BOARD);
 
     /// Destructor
-    ~Sudoku() = default;
+    ~Sudoku();
 
     /**
      * @brief Reset board to initial state
@@ -82,6 +69,57 @@ public:
      */
     void reset(const Board &inputBoard);
 
+    /**
+     * @brief Select the search algorithm
+     * @param engine Engine used by solve() and solveWithSteps()
+     */
+    void setEngine(EngineKind engine);
+
+    /// Get the active search algorithm
+    [[nodiscard]] EngineKind engine() const { return engineKind_; }
+
+    /**
+     * @brief Make solves abortable from another thread
+     * @param token Flag polled by the engine at every search node (nullptr = not cancellable)
+     * @note A cancelled solve returns false and leaves the board partially filled
+     */
+    void setCancelToken(const std::atomic<bool> *token);
+
+    /**
+     * @brief Collect detailed search counters (candidate tests, deductions, depth, phase times)
+     * @param enabled Use the instrumented search; when off, the counters are compiled out
+     *        of the search that runs and stats() reports nodes and backtracks only
+     */
+    void setProfiling(bool enabled);
+
+    /**
+     * @brief Answer solve() from a cache of canonical puzzles
+     * @param cache Shared cache (nullptr = none); must outlive its use here
+     * @note Only solve() consults it; step recording and counting always search
+     */
+    void setCache(SolutionCache *cache);
+
+    /**
+     * @brief Fill the board from the cache
+     * @return true on a hit; on a miss the canonical key is kept for cacheSolution()
+     * @note For callers solving with another solver (e.g. ParallelSolver)
+     */
+    bool solveFromCache();
+
+    /**
+     * @brief Store the solution of the board of the last solveFromCache() miss
+     * @param solution Solved board in the caller's frame
+     */
+    void cacheSolution(const Board &solution);
+
+    /// Whether the last solve() was answered by the cache
+    [[nodiscard]] bool solvedFromCache() const { return cacheHit_; }
+
+    /// Statistics of the last solve (all zero before the first one or after a cache hit)
+    [[nodiscard]] SolveStats stats() const {
+        return engine_ && !cacheHit_ ? engine_->stats() : SolveStats{};
+    }
+
     /**
      * @brief Get cell value
      * @param row Row index (0-8)
@@ -89,7 +127,7 @@ public:
      * @return Cell value (0-9)
      */
     [[nodiscard]] int getCell(int row, int col) const {
-        return getFromBoard(board_, row, col);
+        return board_.get(row, col);
     }
 
     /**
@@ -99,9 +137,12 @@ public:
      * @param val Value to set (0-9)
      */
     void setCell(int row, int col, int val) {
-        setToBoard(board_, row, col, val);
+        board_.set(row, col, val);
     }
 
+    /// Get the current board state
+    [[nodiscard]] const Board &board() const { return board_; }
+
     /**
      * @brief Check if cell was given in initial puzzle
      * @param row Row index (0-8)
@@ -109,7 +150,7 @@ public:
      * @return true if cell is immutable, false otherwise
      */
     [[nodiscard]] bool isGiven(int row, int col) const {
-        return given_[static_cast<size_t>(row)][static_cast<size_t>(col)];
+        return given_.test(static_cast<size_t>(Board::index(row, col)));
     }
 
     /**
@@ -125,7 +166,8 @@ public:
     /**
      * @brief Fast solve without recording steps
      * @return true if puzzle has solution, false if unsolvable
-     * @note Uses backtracking algorithm O(9^k)
+     * @note Uses backtracking algorithm O(9^k); with a cache set, solved puzzles
+     *       are remembered and their symmetric copies solved by lookup
      */
     bool solve();
 
@@ -136,7 +178,29 @@ public:
      * @note Records both placements and removals (backtrack) steps
      */
     bool solveWithSteps(std::vector<SolveStep> &steps);
+
+    /**
+     * @brief Solve while streaming every step into a sink
+     * @param sink Receives placements, removals and deductions as they happen
+     * @return true if puzzle has solution, false if unsolvable (or cancelled)
+     * @note Memory use does not grow with the trace length; see StepStream
+     */
+    bool solveWithSteps(StepSink &sink);
+
+    /**
+     * @brief Count solutions of the current board with early exit
+     * @param limit Stop as soon as this many solutions are found
+     * @return Number of solutions found, at most limit
+     * @note Board is left unchanged; stats() reports the counting search
+     */
+    [[nodiscard]] std::uint64_t countSolutions(std::uint64_t limit);
+
+    /**
+     * @brief Check that the current board is a well-formed puzzle
+     * @return true if exactly one solution exists
+     * @note Stops after the second solution, so it costs at most two searches
+     */
+    [[nodiscard]] bool hasUniqueSolution();
 };
 
 #endif // SUDOKU_HPP
-
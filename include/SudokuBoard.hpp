@@ -0,0 +1,207 @@
+#ifndef SUDOKU_BOARD_HPP
+#define SUDOKU_BOARD_HPP
+
+#include <array>
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+/**
+ * @brief Character of a cell value in the text formats
+ * @param value Cell value (0 = empty, 1-25)
+ * @return '.' for empty, '1'-'9', then 'A' (10) to 'P' (25)
+ */
+constexpr char cellSymbol(const int value) {
+    if (value == 0) return '.';
+    return static_cast<char>(value <= 9 ? '0' + value : 'A' + value - 10);
+}
+
+/**
+ * @brief Cell value of a character in the text formats (inverse of cellSymbol())
+ * @param ch '.' or '0' (empty), '1'-'9', 'A'-'P' or 'a'-'p'
+ * @return Value 0-25, or -1 if ch is not a cell character
+ */
+constexpr int cellValue(const char ch) {
+    if (ch == '.' || ch == '0') return 0;
+    if (ch >= '1' && ch <= '9') return ch - '0';
+    if (ch >= 'A' && ch <= 'P') return ch - 'A' + 10;
+    if (ch >= 'a' && ch <= 'p') return ch - 'a' + 10;
+    return -1;
+}
+
+/**
+ * @struct BasicBoard
+ * @brief Fixed-size board of (Box*Box)^2 bytes in row-major order
+ * @tparam Box Box side: 2 (4x4), 3 (9x9), 4 (16x16) or 5 (25x25)
+ * @details
+ *   - Trivially copyable value type: a copy is one memcpy, no allocation
+ *   - Cell (row, col) lives at index row * SIZE + col
+ *   - Geometry is compile-time, so loops over rows, units and digits have constant
+ *     bounds and solvers get the narrowest digit mask for the size (see Mask)
+ *   - Nested-vector constructor/toRows() are kept only as a conversion layer
+ */
+template<int Box>
+struct BasicBoard {
+    static_assert(Box >= 2 && Box <= 5, "supported sizes are 4x4, 9x9, 16x16 and 25x25");
+
+    static constexpr int BOX = Box; ///< Box side (3 for 9x9)
+    static constexpr int SIZE = Box * Box; ///< Grid size (digits per unit)
+    static constexpr int CELLS = SIZE * SIZE; ///< Number of cells
+
+    /// Digit set, bit (n - 1) represents digit n: 8 bits for 4x4, 16 up to 16x16, 32 for 25x25
+    using Mask = std::conditional_t<(SIZE <= 8), std::uint8_t,
+                                    std::conditional_t<(SIZE <= 16), std::uint16_t, std::uint32_t> >;
+
+    /// Smallest type holding a cell index
+    using Index = std::conditional_t<(CELLS <= 256), std::uint8_t, std::uint16_t>;
+
+    std::array<std::uint8_t, CELLS> cells{}; ///< Cell values (0 = empty)
+
+    /// Empty board
+    constexpr BasicBoard() = default;
+
+    /**
+     * @brief Construct from nested row literals (used by puzzle tables)
+     * @param rows Up to SIZE rows of up to SIZE values (0 = empty cell); extra rows
+     *        and values are ignored, like the nested-vector conversion
+     */
+    constexpr BasicBoard(std::initializer_list<std::initializer_list<int> > rows) {
+        int r = 0;
+        for (auto row = rows.begin(); row != rows.end() && r < SIZE; ++row, ++r) {
+            int c = 0;
+            for (auto val = row->begin(); val != row->end() && c < SIZE; ++val, ++c) set(r, c, *val);
+        }
+    }
+
+    /**
+     * @brief Conversion from the legacy nested-vector representation
+     * @param rows SIZE x SIZE board (0 = empty cell)
+     */
+    BasicBoard(const std::vector<std::vector<int> > &rows) { // NOLINT(google-explicit-constructor)
+        for (size_t r = 0; r < rows.size() && r < SIZE; ++r)
+            for (size_t c = 0; c < rows[r].size() && c < SIZE; ++c)
+                cells[r * SIZE + c] = static_cast<std::uint8_t>(rows[r][c]);
+    }
+
+    /// Flat index of (row, col)
+    static constexpr int index(int row, int col) { return row * SIZE + col; }
+
+    /// Box containing (row, col), numbered row-major
+    static constexpr int boxOf(int row, int col) { return (row / BOX) * BOX + col / BOX; }
+
+    /**
+     * @brief Get cell value
+     * @param row Row index (0 to SIZE - 1)
+     * @param col Column index (0 to SIZE - 1)
+     * @return Cell value (0 to SIZE)
+     */
+    [[nodiscard]] constexpr int get(int row, int col) const {
+        return cells[static_cast<size_t>(index(row, col))];
+    }
+
+    /**
+     * @brief Set cell value
+     * @param row Row index (0 to SIZE - 1)
+     * @param col Column index (0 to SIZE - 1)
+     * @param val Value to set (0 to SIZE)
+     */
+    constexpr void set(int row, int col, int val) {
+        cells[static_cast<size_t>(index(row, col))] = static_cast<std::uint8_t>(val);
+    }
+
+    /**
+     * @brief Convert to the legacy nested-vector representation
+     * @return SIZE x SIZE board (allocates, avoid on hot paths)
+     */
+    [[nodiscard]] std::vector<std::vector<int> > toRows() const {
+        std::vector<std::vector<int> > rows(SIZE, std::vector<int>(SIZE, 0));
+        for (int r = 0; r < SIZE; ++r)
+            for (int c = 0; c < SIZE; ++c)
+                rows[static_cast<size_t>(r)][static_cast<size_t>(c)] = get(r, c);
+        return rows;
+    }
+
+    /**
+     * @brief Parse the standard one-line puzzle format (81 characters for 9x9)
+     * @param text Row-major cells (see cellValue()): '1'-'9' then 'A'-'P' given,
+     *        '0' or '.' empty; trailing text is ignored
+     * @param out Receives the board on success
+     * @return false if text does not start with CELLS cell characters of this size
+     */
+    static bool parse(std::string_view text, BasicBoard &out) {
+        if (text.size() < CELLS) return false;
+        for (size_t i = 0; i < CELLS; ++i) {
+            const int value = cellValue(text[i]);
+            if (value < 0 || value > SIZE) return false;
+            out.cells[i] = static_cast<std::uint8_t>(value);
+        }
+        return true;
+    }
+
+    /**
+     * @brief Format as the standard one-line puzzle format
+     * @return Row-major cell characters, '.' for empty cells
+     */
+    [[nodiscard]] std::string toString() const {
+        std::string text;
+        text.reserve(CELLS);
+        appendTo(text);
+        return text;
+    }
+
+    /**
+     * @brief Append the one-line puzzle format to text
+     * @param text Output buffer; does not allocate when its capacity suffices
+     */
+    void appendTo(std::string &text) const {
+        for (const std::uint8_t value: cells) text += cellSymbol(value);
+    }
+
+    bool operator==(const BasicBoard &) const = default;
+};
+
+/**
+ * @brief Box side of the board with a given number of cells
+ * @param cells Cell count, e.g. the length of a one-line puzzle
+ * @return 2 (16 cells), 3 (81), 4 (256) or 5 (625); 0 for any other count
+ */
+constexpr int boxSizeForCells(const std::size_t cells) {
+    for (int box = 2; box <= 5; ++box)
+        if (cells == static_cast<std::size_t>(box * box * box * box)) return box;
+    return 0;
+}
+
+/**
+ * @brief Run code written for one board size with a size picked at runtime
+ * @param box Box side (2-5; anything else is treated as 3)
+ * @param f Generic callable taking std::integral_constant<int, Box>, so Box is
+ *          a compile-time constant inside (like BasicSolverEngine::dispatch())
+ * @return Result of f
+ */
+template<typename F>
+decltype(auto) withBoxSize(const int box, F &&f) {
+    switch (box) {
+        case 2: return f(std::integral_constant<int, 2>{});
+        case 4: return f(std::integral_constant<int, 4>{});
+        case 5: return f(std::integral_constant<int, 5>{});
+        default: return f(std::integral_constant<int, 3>{});
+    }
+}
+
+/// The classic 9x9 board, used by every 9x9-only component
+using SudokuBoard = BasicBoard<3>;
+
+static_assert(sizeof(SudokuBoard) == SudokuBoard::CELLS, "SudokuBoard must stay 81 bytes");
+static_assert(std::is_trivially_copyable_v<SudokuBoard>, "SudokuBoard must copy as plain bytes");
+static_assert(std::is_same_v<SudokuBoard::Mask, std::uint16_t> && std::is_same_v<BasicBoard<4>::Mask, std::uint16_t>
+              && std::is_same_v<BasicBoard<5>::Mask, std::uint32_t>);
+
+/// One bit per cell (row-major), set for cells given in the initial puzzle
+using GivenMask = std::bitset<SudokuBoard::CELLS>;
+
+#endif // SUDOKU_BOARD_HPP
@@ -1,7 +1,10 @@
 #ifndef SUDOKU_CELL_HPP
 #define SUDOKU_CELL_HPP
 
-#include <QWidget>
+#include <QPixmap>
+#include <QRect>
+
+class QPainter;
 
 /**
  * @enum CellState
@@ -12,72 +15,54 @@ enum class CellState {
     Given, ///< Cell was given in initial puzzle
     UserInput, ///< Cell value entered by user
     Solved, ///< Cell value computed by solver
+    Deduced, ///< Cell value forced by constraint propagation
     Backtrack, ///< Cell was removed during backtracking
     Invalid ///< Cell contains invalid value (future use)
 };
 
+/// Number of CellState values (rows of the glyph atlas)
+inline constexpr int CELL_STATE_COUNT = static_cast<int>(CellState::Invalid) + 1;
+
 /**
  * @class SudokuCell
- * @brief Single cell widget in Sudoku grid
+ * @brief Model and painter of a single grid cell
  * @details
- *   - Fixed size 56x56 pixels
+ *   - Plain value type; SudokuGrid keeps all cells in one flat array
+ *     and paints them in a single pass (no per-cell widget)
  *   - Supports visual states (selected, highlighted)
- *   - Emits cellClicked signal on mouse press
- *   - Custom paint for rendering values with colors
+ *   - Setters report whether anything visible changed, so the grid
+ *     only schedules repaints for cells that need one
+ *   - Digits are blitted from a pre-rendered glyph atlas (see renderGlyphs());
+ *     painting a cell is one fill and at most one pixmap copy
  */
-class SudokuCell : public QWidget {
-    Q_OBJECT
-
-    int row_; ///< Row index (0-8)
-    int col_; ///< Column index (0-8)
-    int value_; ///< Cell value (0-9)
-    CellState state_; ///< Current cell state
-    bool selected_; ///< Is cell selected by user
-    bool highlighted_; ///< Is cell highlighted (same row/col/box)
-
-protected:
-    /**
-     * @brief Custom painting for cell rendering
-     * @param event Paint event
-     */
-    void paintEvent(QPaintEvent *event) override;
-
-    /**
-     * @brief Handle mouse press to select cell
-     * @param event Mouse event
-     */
-    void mousePressEvent(QMouseEvent *event) override;
+class SudokuCell {
+    int value_{0}; ///< Cell value (0 to the grid size)
+    CellState state_{CellState::Empty}; ///< Current cell state
+    bool selected_{false}; ///< Is cell selected by user
+    bool highlighted_{false}; ///< Is cell highlighted (same row/col/box)
 
 public:
-    /**
-     * @brief Constructor
-     * @param row Row index (0-8)
-     * @param col Column index (0-8)
-     * @param parent Parent widget
-     */
-    SudokuCell(int row, int col, QWidget *parent = nullptr);
-
-    /// Destructor
-    ~SudokuCell() override = default;
-
     /**
      * @brief Set cell value and state
-     * @param val Value (0-9)
+     * @param val Value (0 to the grid size)
      * @param state Cell state
+     * @return true if the cell looks different now
      */
-    void setValue(int val, CellState state);
+    bool setValue(int val, CellState state);
 
     /**
      * @brief Set cell selection state
      * @param sel true if selected
+     * @return true if the cell looks different now
      */
-    void setSelected(bool sel);
+    bool setSelected(bool sel);
 
     /**
      * @brief Set cell highlight state
      * @param h true if highlighted
+     * @return true if the cell looks different now
      */
-    void setHighlighted(bool h);
+    bool setHighlighted(bool h);
 
     /// Get current cell value
     [[nodiscard]] int value() const { return value_; }
@@ -85,20 +70,22 @@ public:
     /// Get current cell state
     [[nodiscard]] CellState state() const { return state_; }
 
-    /// Get row index
-    [[nodiscard]] int row() const { return row_; }
-
-    /// Get column index
-    [[nodiscard]] int col() const { return col_; }
+    /**
+     * @brief Render the cell symbols in every state colour
+     * @param cellSize Tile size in logical pixels
+     * @param digits Number of symbols: 1-9, then A-P (see cellSymbol())
+     * @param dpr Device pixel ratio of the target screen
+     * @return Transparent atlas, one row per CellState and one column per digit
+     */
+    [[nodiscard]] static QPixmap renderGlyphs(int cellSize, int digits, qreal dpr);
 
-signals:
     /**
-     * @brief Emitted when cell is clicked
-     * @param row Row index
-     * @param col Column index
+     * @brief Render the cell
+     * @param p Painter of the owning grid
+     * @param rect Cell area in grid coordinates
+     * @param glyphs Atlas from renderGlyphs() for rect's size
      */
-    void cellClicked(int row, int col);
+    void paint(QPainter &p, const QRect &rect, const QPixmap &glyphs) const;
 };
 
 #endif // SUDOKU_CELL_HPP
-
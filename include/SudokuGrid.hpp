@@ -3,65 +3,127 @@
 
 #include <QWidget>
 #include <array>
+#include <bitset>
+#include <cstdint>
+#include <span>
 #include <vector>
 #include "SudokuCell.hpp"
 #include "Sudoku.hpp"
 
 /**
  * @class SudokuGrid
- * @brief 9x9 Sudoku grid widget with interactive UI
+ * @brief Sudoku grid widget with interactive UI (4x4, 9x9, 16x16 or 25x25)
  * @details
- *   - Manages 81 SudokuCell widgets
- *   - Handles user input (keyboard and mouse)
- *   - Draws grid lines and 3x3 box separators
- *   - Size: 540x540 pixels with optimized layout
+ *   - Keeps the cells as a flat SudokuCell model and paints them
+ *     in one pass; only cells whose (value, state, selected, highlighted)
+ *     tuple changed are invalidated, digits come from a glyph atlas
+ *   - Handles user input (keyboard and mouse); clicks are mapped to
+ *     cells arithmetically from the layout
+ *   - Draws grid lines and box separators
+ *   - The board size follows the loaded puzzle; the cell size shrinks with it
+ *     so every size fits in about 540x540 pixels (9x9: 56 px cells, exactly 540)
  */
 class SudokuGrid : public QWidget
 {
     Q_OBJECT
 
-    // Type alias for cell array
-    using CellArray = std::array<std::array<SudokuCell *, 9>, 9>;
-
     // Constants for layout
-    static constexpr int CELL_SIZE = 56;                          ///< Each cell size in pixels
-    static constexpr int THIN_GAP = 2;                            ///< Gap between cells
-    static constexpr int THICK_GAP = 6;                           ///< Gap between 3x3 boxes
-    static constexpr int PADDING = 6;                             ///< Outer padding
-    static constexpr int BOX_SPAN = 3 * CELL_SIZE + 2 * THIN_GAP; ///< 3x3 box width
-    static constexpr int CONTENT = 3 * BOX_SPAN + 2 * THICK_GAP;  ///< Content area
-    static constexpr int WIDGET_SZ = CONTENT + 2 * PADDING;       ///< Total widget size
+    static constexpr int THIN_GAP = 2;  ///< Gap between cells
+    static constexpr int THICK_GAP = 6; ///< Gap between boxes
+    static constexpr int PADDING = 6;   ///< Outer padding
+    static constexpr std::array<int, 4> CELL_SIZES = {128, 56, 30, 18}; ///< Cell size in pixels for box sides 2-5
+
+    int box_ = 0;                        ///< Box side (3 for 9x9)
+    int size_ = 0;                       ///< Cells per row
+    int cellSize_ = 0;                   ///< Each cell size in pixels
+    int boxSpan_ = 0;                    ///< Box width
+    int content_ = 0;                    ///< Content area
+    int widgetSize_ = 0;                 ///< Total widget size
+
+    std::vector<SudokuCell> cells_;      ///< Cell model, row-major
+    std::vector<std::uint8_t> initial_;  ///< Initial puzzle (immutable)
+    int selectedRow_ = -1;               ///< Currently selected row
+    int selectedCol_ = -1;               ///< Currently selected column
+    QPixmap glyphs_;                     ///< Digit atlas, rebuilt when the size or device pixel ratio changes
 
-    CellArray cells_{};                          ///< 9x9 grid of cells
-    std::vector<std::vector<int>> initialBoard_; ///< Initial puzzle (immutable)
-    int selectedRow_ = -1;                       ///< Currently selected row
-    int selectedCol_ = -1;                       ///< Currently selected column
+    /**
+     * @brief Switch the board size and recompute the layout
+     * @param box Box side (2-5); the model is resized and emptied if it changes
+     */
+    void setBoxSize(int box);
+
+    /**
+     * @brief Load a puzzle of any size
+     * @param box Box side of the puzzle
+     * @param values Row-major cell values (0 = empty), box^4 of them
+     */
+    void loadCells(int box, std::span<const std::uint8_t> values);
 
     /**
      * @brief Calculate X coordinate for cell
-     * @param col Column index (0-8)
+     * @param col Column index (0 to size() - 1)
      * @return X coordinate in pixels
      */
-    [[nodiscard]] static int cellX(int col);
+    [[nodiscard]] int cellX(int col) const;
 
     /**
      * @brief Calculate Y coordinate for cell
-     * @param row Row index (0-8)
+     * @param row Row index (0 to size() - 1)
      * @return Y coordinate in pixels
      */
-    [[nodiscard]] static int cellY(int row);
+    [[nodiscard]] int cellY(int row) const;
+
+    /**
+     * @brief Map a pixel coordinate to a row or column index
+     * @param pos X (for columns) or Y (for rows) in widget coordinates
+     * @return Index (0 to size() - 1), or -1 on padding and gaps
+     * @details Inverse of cellX()/cellY(); same formula for both axes
+     */
+    [[nodiscard]] int cellAt(int pos) const;
+
+    /**
+     * @brief Area of a cell in widget coordinates
+     * @param row Row index (0 to size() - 1)
+     * @param col Column index (0 to size() - 1)
+     */
+    [[nodiscard]] QRect cellRect(int row, int col) const;
+
+    /**
+     * @brief Access a cell of the model
+     * @param row Row index (0 to size() - 1)
+     * @param col Column index (0 to size() - 1)
+     */
+    [[nodiscard]] SudokuCell &cell(int row, int col) {
+        return cells_[static_cast<size_t>(row * size_ + col)];
+    }
+
+    /// Read-only access to a cell of the model
+    [[nodiscard]] const SudokuCell &cell(int row, int col) const {
+        return cells_[static_cast<size_t>(row * size_ + col)];
+    }
+
+    /// Schedule a repaint of one cell (Qt merges the rects of a frame)
+    void repaintCell(int row, int col);
+
+    /**
+     * @brief Select a cell and highlight its row, column and box
+     * @param row Row of the cell
+     * @param col Column of the cell
+     */
+    void selectCell(int row, int col);
 
     /**
      * @brief Update highlighted cells for a selection
-     * @param row Selected row
+     * @param row Selected row (-1 = no selection)
      * @param col Selected column
-     * @details Highlights same row, column, and 3x3 box
+     * @details Highlights same row, column, and box; cells highlighted
+     *          before and after are left alone (no repaint)
      */
     void updateHighlights(int row, int col);
 
 protected:
     /**
-     * @brief Render grid lines and separators
+     * @brief Render grid lines, separators and every cell in the update region
      * @param event Paint event
      */
     void paintEvent(QPaintEvent *event) override;
@@ -72,6 +134,12 @@ protected:
      */
     void keyPressEvent(QKeyEvent *event) override;
 
+    /**
+     * @brief Select the cell under the cursor
+     * @param event Mouse event
+     */
+    void mousePressEvent(QMouseEvent *event) override;
+
 public:
     /**
      * @brief Constructor
@@ -82,11 +150,18 @@ public:
     /// Destructor
     ~SudokuGrid() override = default;
 
+    /// Box side of the board shown (3 for 9x9)
+    [[nodiscard]] int boxSize() const { return box_; }
+
+    /// Cells per row of the board shown (9 for 9x9)
+    [[nodiscard]] int size() const { return size_; }
+
     /**
-     * @brief Load new puzzle board
-     * @param board 9x9 board (0 = empty cell)
+     * @brief Load new puzzle board; the grid takes the size of the board
+     * @param board Board of any supported size (0 = empty cell)
      */
-    void loadBoard(const std::vector<std::vector<int>> &board);
+    template<int Box>
+    void loadBoard(const BasicBoard<Box> &board) { loadCells(Box, board.cells); }
 
     /**
      * @brief Apply a single solving step
@@ -94,6 +169,20 @@ public:
      */
     void applyStep(const SolveStep &step);
 
+    /**
+     * @brief Show an arbitrary solve state (used when seeking through a trace)
+     * @param board Cell values to show; must have the size of the grid
+     * @param deduced Cells to colour as deductions rather than guesses
+     */
+    template<int Box>
+    void showBoard(const BasicBoard<Box> &board, const std::bitset<BasicBoard<Box>::CELLS> &deduced) {
+        for (int r = 0; r < BasicBoard<Box>::SIZE; ++r)
+            for (int c = 0; c < BasicBoard<Box>::SIZE; ++c) {
+                const bool isDeduced = deduced[static_cast<size_t>(BasicBoard<Box>::index(r, c))];
+                applyStep({r, c, board.get(r, c), isDeduced ? StepKind::Deduced : StepKind::Guess});
+            }
+    }
+
     /**
      * @brief Mark all solved cells with solved state
      */
@@ -106,17 +195,21 @@ public:
 
     /**
      * @brief Get current board state
-     * @return 9x9 board with all cell values
+     * @return Board with all cell values (no allocation); Box must match boxSize()
      */
-    [[nodiscard]] std::vector<std::vector<int>> getCurrentBoard() const;
+    template<int Box>
+    [[nodiscard]] BasicBoard<Box> currentBoard() const {
+        BasicBoard<Box> board;
+        for (size_t i = 0; i < board.cells.size(); ++i)
+            board.cells[i] = static_cast<std::uint8_t>(cells_[i].value());
+        return board;
+    }
 
-private slots:
     /**
-     * @brief Handle cell click
-     * @param row Row of clicked cell
-     * @param col Column of clicked cell
+     * @brief Get current board state of a 9x9 grid
+     * @return 9x9 board with all cell values (no allocation)
      */
-    void onCellClicked(int row, int col);
+    [[nodiscard]] SudokuBoard getCurrentBoard() const { return currentBoard<3>(); }
 };
 
 #endif // SUDOKU_GRID_HPP
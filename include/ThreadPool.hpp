@@ -0,0 +1,110 @@
+#ifndef THREAD_POOL_HPP
+#define THREAD_POOL_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @class ThreadPool
+ * @brief Fixed-size work-stealing thread pool
+ * @details
+ *   - One task deque per worker: the owner pops newest-first (LIFO, cache-warm),
+ *     idle workers steal oldest-first (FIFO) from the others
+ *   - Tasks submitted from outside the pool are spread round-robin;
+ *     tasks submitted by a worker go to its own deque
+ *   - Workers sleep on a condition variable when every deque is empty
+ *   - No allocation per task once the deques have grown to the peak load,
+ *     provided the task's captures fit std::function's small buffer (one pointer)
+ *   - currentWorker() lets tasks index per-worker scratch state without locking
+ */
+class ThreadPool {
+public:
+    using Task = std::function<void()>; ///< Unit of work
+
+private:
+    /**
+     * @struct Worker
+     * @brief Per-thread task deque
+     * @details A ring over a vector that doubles when full and never shrinks, so
+     *          once it has seen its peak load, queueing a task does not allocate
+     *          (std::deque frees and reallocates blocks as the ends move)
+     */
+    struct Worker {
+        static constexpr std::size_t INITIAL_CAPACITY = 64; ///< Slots before the first growth (power of two)
+
+        std::mutex mutex; ///< Guards everything below
+        std::vector<Task> ring = std::vector<Task>(INITIAL_CAPACITY); ///< Slots, size is a power of two
+        std::size_t head{0}; ///< Oldest task (thieves take it), free-running
+        std::size_t tail{0}; ///< One past the newest task (owner takes it), free-running
+
+        /// No task queued
+        [[nodiscard]] bool empty() const { return head == tail; }
+
+        /// Append a task at the back, growing the ring when full
+        void pushBack(Task &&task);
+
+        /// Remove the newest task (owner side)
+        void popBack(Task &task);
+
+        /// Remove the oldest task (thief side)
+        void popFront(Task &task);
+    };
+
+    std::vector<std::unique_ptr<Worker> > workers_; ///< One deque per thread
+    std::vector<std::thread> threads_; ///< Worker threads
+    std::mutex sleepMutex_; ///< Guards sleeping workers
+    std::condition_variable wake_; ///< Signalled when work arrives or on shutdown
+    std::atomic<std::size_t> pending_{0}; ///< Tasks queued but not yet started
+    std::atomic<std::size_t> nextQueue_{0}; ///< Round-robin cursor for external submits
+    bool stop_{false}; ///< Shutdown requested (guarded by sleepMutex_)
+
+    /**
+     * @brief Take a task from worker self, or steal one from a sibling
+     * @param self Index of the calling worker
+     * @param task Receives the task
+     * @return true if a task was obtained
+     */
+    bool acquire(std::size_t self, Task &task);
+
+    /**
+     * @brief Worker thread main loop
+     * @param index Worker index
+     */
+    void run(std::size_t index);
+
+public:
+    /**
+     * @brief Start the worker threads
+     * @param threads Number of workers (0 = one per hardware thread)
+     */
+    explicit ThreadPool(std::size_t threads = 0);
+
+    /// Finish all queued tasks, then join the workers
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool &operator=(const ThreadPool &) = delete;
+
+    /**
+     * @brief Queue a task
+     * @param task Work to run on some worker
+     */
+    void submit(Task task);
+
+    /// Number of worker threads
+    [[nodiscard]] std::size_t size() const { return threads_.size(); }
+
+    /**
+     * @brief Index of the calling worker thread
+     * @return Worker index in [0, size()), or -1 when called outside any pool
+     */
+    [[nodiscard]] static int currentWorker();
+};
+
+#endif // THREAD_POOL_HPP
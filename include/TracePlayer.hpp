@@ -0,0 +1,118 @@
+#ifndef TRACE_PLAYER_HPP
+#define TRACE_PLAYER_HPP
+
+#include <bitset>
+#include <chrono>
+#include <cstddef>
+#include <vector>
+#include "CompactTrace.hpp"
+
+/**
+ * @class BasicTracePlayer
+ * @brief Random-access playback of a solve trace
+ * @tparam Box Box side of the solved board (see BasicBoard)
+ * @details
+ *   - Steps are stored as CompactTrace codes without bounce coalescing,
+ *     so step i is codes[i] (O(1) access)
+ *   - A board snapshot is taken every interval steps while recording;
+ *     seek(n) restores the nearest snapshot at or before n and replays at most
+ *     interval - 1 steps, so random access costs O(interval) whatever the trace length
+ *   - Recording and playback are independent: steps may be appended while playing
+ */
+template<int Box>
+class BasicTracePlayer {
+public:
+    using Board = BasicBoard<Box>; ///< Board type played back
+    using Cells = std::bitset<Board::CELLS>; ///< One bit per cell (row-major)
+
+    static constexpr std::size_t DEFAULT_INTERVAL = 1024; ///< Steps between snapshots
+    static constexpr std::size_t CLOCK_STRIDE = 4096; ///< Steps between deadline checks in advance()
+
+    /**
+     * @struct Frame
+     * @brief Board state after some number of steps
+     */
+    struct Frame {
+        Board board; ///< Cell values
+        Cells deduced; ///< Cells whose current value was deduced (not guessed)
+    };
+
+private:
+    std::size_t interval_; ///< Steps between snapshots
+    BasicCompactTrace<Box> trace_{false}; ///< Recorded steps, one code each
+    std::vector<Frame> snapshots_; ///< snapshots_[k] = state after k * interval_ steps
+    Frame recordHead_; ///< State after every recorded step
+    Frame frame_; ///< State after position_ steps
+    std::size_t position_{0}; ///< Steps applied to frame_
+
+    /// Apply one step to a frame
+    static void apply(Frame &frame, const SolveStep &step);
+
+public:
+    /**
+     * @brief Create an empty player
+     * @param interval Steps between snapshots (memory vs. seek cost)
+     */
+    explicit BasicTracePlayer(std::size_t interval = DEFAULT_INTERVAL);
+
+    /**
+     * @brief Drop the trace and start over from a puzzle
+     * @param start Board before the first step
+     */
+    void reset(const Board &start);
+
+    /// Record the next step of the trace
+    void append(const SolveStep &step);
+
+    /// Number of recorded steps
+    [[nodiscard]] std::size_t size() const { return trace_.size(); }
+
+    /// Number of steps applied to frame()
+    [[nodiscard]] std::size_t position() const { return position_; }
+
+    /// Board state at position()
+    [[nodiscard]] const Frame &frame() const { return frame_; }
+
+    /**
+     * @brief Recorded step
+     * @param index Step index (< size())
+     * @return Decoded step
+     */
+    [[nodiscard]] SolveStep step(std::size_t index) const {
+        return BasicCompactTrace<Box>::decode(trace_.codes()[index]);
+    }
+
+    /**
+     * @brief Apply the step at position() and advance
+     * @return The applied step (only valid if position() < size() beforehand)
+     */
+    SolveStep stepForward();
+
+    /**
+     * @brief Move the playback position
+     * @param target Step count to show, clamped to size()
+     */
+    void seek(std::size_t target);
+
+    /**
+     * @brief Apply a batch of steps, coalescing repeated writes to the same cell
+     * @param count Steps to apply (stops early at size())
+     * @param touched Receives the cells whose value may have changed; a display
+     *        only needs to redraw these, once, with their state from frame()
+     * @param deadline Stop early once this time has passed (checked every CLOCK_STRIDE steps)
+     * @return Number of steps applied
+     * @note Skips longer than two snapshot intervals go through seek() and mark every cell
+     */
+    std::size_t advance(std::size_t count, Cells &touched,
+                        std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::time_point::max());
+};
+
+/// Player of a 9x9 trace
+using TracePlayer = BasicTracePlayer<3>;
+
+extern template class BasicTracePlayer<2>;
+extern template class BasicTracePlayer<3>;
+extern template class BasicTracePlayer<4>;
+extern template class BasicTracePlayer<5>;
+
+#endif // TRACE_PLAYER_HPP
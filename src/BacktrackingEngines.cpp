@@ -0,0 +1,426 @@
+#include "BacktrackingEngines.hpp"
+#include <bit>
+
+namespace {
+    /// Cell indices of the 3 * SIZE units: rows, then columns, then boxes
+    template<int Box>
+    constexpr auto UNITS = [] {
+        using Board = BasicBoard<Box>;
+        using Index = typename Board::Index;
+        constexpr int SIZE = Board::SIZE;
+        std::array<std::array<Index, SIZE>, 3 * SIZE> units{};
+        for (int i = 0; i < SIZE; ++i) {
+            for (int j = 0; j < SIZE; ++j) {
+                units[static_cast<size_t>(i)][static_cast<size_t>(j)] = static_cast<Index>(i * SIZE + j);
+                units[static_cast<size_t>(SIZE + i)][static_cast<size_t>(j)] = static_cast<Index>(j * SIZE + i);
+                const int r = (i / Box) * Box + j / Box;
+                const int c = (i % Box) * Box + j % Box;
+                units[static_cast<size_t>(2 * SIZE + i)][static_cast<size_t>(j)] = static_cast<Index>(r * SIZE + c);
+            }
+        }
+        return units;
+    }();
+}
+
+// ────────────────────────────────────────────────────────────────────────────────
+// BasicNaiveEngine
+// ────────────────────────────────────────────────────────────────────────────────
+
+// Validity check: ensure placing 'num' at (row, col) doesn't violate Sudoku rules
+template<int Box>
+bool BasicNaiveEngine<Box>::isValid(const Board &board, const int row, const int col, const int num) {
+    // Check row and column
+    for (int i = 0; i < Board::SIZE; ++i) {
+        if (i != col && board.get(row, i) == num) return false;
+        if (i != row && board.get(i, col) == num) return false;
+    }
+    // Check box
+    const int br = (row / Box) * Box;
+    const int bc = (col / Box) * Box;
+    for (int r = br; r < br + Box; ++r)
+        for (int c = bc; c < bc + Box; ++c)
+            if ((r != row || c != col) && board.get(r, c) == num) return false;
+    return true;
+}
+
+template<int Box>
+template<bool RecordSteps, bool Profile>
+bool BasicNaiveEngine<Box>::search(StepSink *steps) {
+    if (cancelled()) return false;
+    for (int r = 0; r < Board::SIZE; ++r) {
+        for (int c = 0; c < Board::SIZE; ++c) {
+            if (board_->get(r, c) != 0) continue;
+            for (int num = 1; num <= Board::SIZE; ++num) {
+                this->template tally<Profile>(stats_.candidateTests);
+                if (!isValid(*board_, r, c, num)) continue;
+                board_->set(r, c, num);
+                ++stats_.nodes;
+                this->template descend<Profile>();
+                if constexpr (RecordSteps) steps->push({r, c, num}); // record placement
+                if (search<RecordSteps, Profile>(steps)) return true;
+                board_->set(r, c, 0); // backtrack
+                ++stats_.backtracks;
+                this->template ascend<Profile>();
+                if constexpr (RecordSteps) steps->push({r, c, 0}); // record removal
+            }
+            return false; // no number fits -> backtrack
+        }
+    }
+    return true; // all cells filled
+}
+
+template<int Box>
+bool BasicNaiveEngine<Box>::solve(Board &board, StepSink *steps) {
+    stats_ = {};
+    guessDepth_ = 0;
+    board_ = &board;
+    return this->dispatch(steps, [&](auto record, auto profile) {
+        constexpr bool RecordSteps = decltype(record)::value;
+        constexpr bool Profile = decltype(profile)::value;
+        return this->template timed<Profile>(stats_.searchTime, [&] { return search<RecordSteps, Profile>(steps); });
+    });
+}
+
+// ────────────────────────────────────────────────────────────────────────────────
+// BasicMaskEngine
+// ────────────────────────────────────────────────────────────────────────────────
+
+// Rebuild occupancy masks and the empty-cell list; fails if a filled cell repeats a digit
+template<int Box>
+bool BasicMaskEngine<Box>::attach(Board &board) {
+    board_ = &board;
+    rowMask_.fill(0);
+    colMask_.fill(0);
+    boxMask_.fill(0);
+    emptyCount_ = 0;
+    trailSize_ = 0;
+    for (int i = 0; i < CELLS; ++i) {
+        const int val = board.cells[static_cast<size_t>(i)];
+        if (val == 0) {
+            emptyPos_[static_cast<size_t>(i)] = static_cast<Index>(emptyCount_);
+            empty_[static_cast<size_t>(emptyCount_++)] = static_cast<Index>(i);
+            continue;
+        }
+        const auto bit = static_cast<Mask>(1ULL << (val - 1));
+        if ((candidates(i) & bit) == 0) return false;
+        flipMasks(i / SIZE, i % SIZE, bit);
+    }
+    return true;
+}
+
+// MRV choice: 0 or 1 candidates cannot be beaten, callers may stop even earlier
+template<int Box>
+template<bool Profile>
+int BasicMaskEngine<Box>::mostConstrained(Mask &bestCand, const int goodEnough) {
+    int bestPos = 0;
+    int bestCount = SIZE + 1;
+    for (int i = 0; i < emptyCount_; ++i) {
+        this->template tally<Profile>(this->stats_.candidateTests);
+        const Mask cand = candidates(empty_[static_cast<size_t>(i)]);
+        const int count = std::popcount(cand);
+        if (count < bestCount) {
+            bestPos = i;
+            bestCount = count;
+            bestCand = cand;
+            if (count <= goodEnough) break;
+        }
+    }
+    return bestPos;
+}
+
+// ────────────────────────────────────────────────────────────────────────────────
+// BasicBitmaskEngine
+// ────────────────────────────────────────────────────────────────────────────────
+
+// Bitmask search: candidates come from one OR/NOT over the masks, no rescans
+template<int Box>
+template<bool RecordSteps, bool Profile>
+bool BasicBitmaskEngine<Box>::search(int cell, StepSink *steps) {
+    if (cancelled()) return false;
+
+    // Cells before 'cell' are all filled, so resume the row-major scan here
+    while (cell < CELLS && board_->cells[static_cast<size_t>(cell)] != 0) ++cell;
+    if (cell == CELLS) return true; // all cells filled
+
+    const int r = cell / SIZE;
+    const int c = cell % SIZE;
+    this->template tally<Profile>(stats_.candidateTests);
+    for (Mask cand = candidates(r, c); cand != 0; cand &= static_cast<Mask>(cand - 1)) {
+        const auto bit = static_cast<Mask>(cand & -cand);
+        const int num = std::countr_zero(bit) + 1;
+        board_->set(r, c, num);
+        flipMasks(r, c, bit);
+        ++stats_.nodes;
+        this->template descend<Profile>();
+        if constexpr (RecordSteps) steps->push({r, c, num}); // record placement
+        if (search<RecordSteps, Profile>(cell + 1, steps)) return true;
+        flipMasks(r, c, bit);
+        board_->set(r, c, 0); // backtrack
+        ++stats_.backtracks;
+        this->template ascend<Profile>();
+        if constexpr (RecordSteps) steps->push({r, c, 0}); // record removal
+    }
+    return false; // no number fits -> backtrack
+}
+
+template<int Box>
+bool BasicBitmaskEngine<Box>::solve(Board &board, StepSink *steps) {
+    stats_ = {};
+    guessDepth_ = 0;
+    return this->dispatch(steps, [&](auto record, auto profile) {
+        constexpr bool RecordSteps = decltype(record)::value;
+        constexpr bool Profile = decltype(profile)::value;
+        if (!this->template timed<Profile>(stats_.setupTime, [&] { return attach(board); })) return false;
+        return this->template timed<Profile>(stats_.searchTime, [&] { return search<RecordSteps, Profile>(0, steps); });
+    });
+}
+
+// ────────────────────────────────────────────────────────────────────────────────
+// BasicMrvEngine
+// ────────────────────────────────────────────────────────────────────────────────
+
+// MRV search: always branch on the empty cell with the fewest candidates
+template<int Box>
+template<bool RecordSteps, bool Profile>
+bool BasicMrvEngine<Box>::search(StepSink *steps) {
+    if (cancelled()) return false;
+    if (emptyCount_ == 0) return true; // all cells filled
+
+    Mask bestCand = 0;
+    const int bestPos = this->template mostConstrained<Profile>(bestCand, 1);
+    if (bestCand == 0) return false; // dead end -> backtrack
+
+    const int cell = empty_[static_cast<size_t>(bestPos)];
+    const int r = cell / SIZE;
+    const int c = cell % SIZE;
+    takeEmpty(bestPos);
+    for (Mask cand = bestCand; cand != 0; cand &= static_cast<Mask>(cand - 1)) {
+        const auto bit = static_cast<Mask>(cand & -cand);
+        const int num = std::countr_zero(bit) + 1;
+        board_->set(r, c, num);
+        flipMasks(r, c, bit);
+        ++stats_.nodes;
+        this->template descend<Profile>();
+        if constexpr (RecordSteps) steps->push({r, c, num}); // record placement
+        if (search<RecordSteps, Profile>(steps)) return true;
+        flipMasks(r, c, bit);
+        board_->set(r, c, 0); // backtrack
+        ++stats_.backtracks;
+        this->template ascend<Profile>();
+        if constexpr (RecordSteps) steps->push({r, c, 0}); // record removal
+    }
+    restoreEmpty(bestPos);
+    return false;
+}
+
+template<int Box>
+bool BasicMrvEngine<Box>::solve(Board &board, StepSink *steps) {
+    stats_ = {};
+    guessDepth_ = 0;
+    return this->dispatch(steps, [&](auto record, auto profile) {
+        constexpr bool RecordSteps = decltype(record)::value;
+        constexpr bool Profile = decltype(profile)::value;
+        if (!this->template timed<Profile>(stats_.setupTime, [&] { return attach(board); })) return false;
+        return this->template timed<Profile>(stats_.searchTime, [&] { return search<RecordSteps, Profile>(steps); });
+    });
+}
+
+// ────────────────────────────────────────────────────────────────────────────────
+// BasicPropagationEngine
+// ────────────────────────────────────────────────────────────────────────────────
+
+template<int Box>
+template<bool RecordSteps, bool Profile>
+void BasicPropagationEngine<Box>::deduce(int pos, Mask bit, StepSink *steps) {
+    const int cell = empty_[static_cast<size_t>(pos)];
+    const int r = cell / SIZE;
+    const int c = cell % SIZE;
+    const int num = std::countr_zero(bit) + 1;
+    board_->set(r, c, num);
+    flipMasks(r, c, bit);
+    takeEmpty(pos);
+    trail_[static_cast<size_t>(trailSize_++)] = static_cast<Index>(pos);
+    this->template tally<Profile>(stats_.deductions);
+    if constexpr (RecordSteps) steps->push({r, c, num, StepKind::Deduced});
+}
+
+template<int Box>
+template<bool RecordSteps>
+void BasicPropagationEngine<Box>::undoTrail(int mark, StepSink *steps) {
+    while (trailSize_ > mark) {
+        const int pos = trail_[static_cast<size_t>(--trailSize_)];
+        restoreEmpty(pos);
+        const int cell = empty_[static_cast<size_t>(pos)];
+        const int r = cell / SIZE;
+        const int c = cell % SIZE;
+        flipMasks(r, c, static_cast<Mask>(1ULL << (board_->get(r, c) - 1)));
+        board_->set(r, c, 0);
+        if constexpr (RecordSteps) steps->push({r, c, 0, StepKind::Deduced});
+    }
+}
+
+// Naked singles + hidden singles until fixpoint
+template<int Box>
+template<bool RecordSteps, bool Profile>
+bool BasicPropagationEngine<Box>::propagate(StepSink *steps) {
+    bool progress = true;
+    while (progress) {
+        progress = false;
+
+        // Naked singles: walk backwards so the entry swapped into i was already visited
+        for (int i = emptyCount_ - 1; i >= 0; --i) {
+            this->template tally<Profile>(stats_.candidateTests);
+            const Mask cand = candidates(empty_[static_cast<size_t>(i)]);
+            if (cand == 0) return false;
+            if ((cand & (cand - 1)) != 0) continue;
+            deduce<RecordSteps, Profile>(i, cand, steps);
+            progress = true;
+        }
+
+        // Hidden singles: digits that fit in exactly one cell of a unit
+        for (int u = 0; u < 3 * SIZE; ++u) {
+            const auto &unit = UNITS<Box>[static_cast<size_t>(u)];
+            Mask once = 0;
+            Mask twice = 0;
+            for (const auto cell: unit) {
+                if (board_->cells[cell] != 0) continue;
+                this->template tally<Profile>(stats_.candidateTests);
+                const Mask cand = candidates(cell);
+                twice |= static_cast<Mask>(once & cand);
+                once |= cand;
+            }
+            if ((once | unitMask(u)) != ALL_DIGITS) return false; // some digit has no place left
+
+            for (Mask hidden = static_cast<Mask>(once & ~twice); hidden != 0; hidden &= static_cast<Mask>(hidden - 1)) {
+                const auto bit = static_cast<Mask>(hidden & -hidden);
+                bool placed = false;
+                for (const auto cell: unit) {
+                    if (board_->cells[cell] != 0 || (candidates(cell) & bit) == 0) continue;
+                    deduce<RecordSteps, Profile>(emptyPos_[cell], bit, steps);
+                    placed = true;
+                    break;
+                }
+                if (!placed) return false; // two hidden digits claimed the same cell
+                progress = true;
+            }
+        }
+    }
+    return true;
+}
+
+// Propagation search: deduce everything forced, then branch MRV-style
+template<int Box>
+template<bool RecordSteps, bool Profile>
+bool BasicPropagationEngine<Box>::search(StepSink *steps) {
+    if (cancelled()) return false;
+    const int mark = trailSize_;
+    const auto propagation = [&] { return propagate<RecordSteps, Profile>(steps); };
+    if (!this->template timed<Profile>(stats_.propagationTime, propagation)) {
+        undoTrail<RecordSteps>(mark, steps);
+        return false;
+    }
+    if (emptyCount_ == 0) return true; // all cells filled
+
+    Mask bestCand = 0;
+    const int bestPos = this->template mostConstrained<Profile>(bestCand, 2); // singles were already propagated
+
+    const int cell = empty_[static_cast<size_t>(bestPos)];
+    const int r = cell / SIZE;
+    const int c = cell % SIZE;
+    takeEmpty(bestPos);
+    for (Mask cand = bestCand; cand != 0; cand &= static_cast<Mask>(cand - 1)) {
+        const auto bit = static_cast<Mask>(cand & -cand);
+        const int num = std::countr_zero(bit) + 1;
+        board_->set(r, c, num);
+        flipMasks(r, c, bit);
+        ++stats_.nodes;
+        this->template descend<Profile>();
+        if constexpr (RecordSteps) steps->push({r, c, num}); // record guess
+        if (search<RecordSteps, Profile>(steps)) return true;
+        flipMasks(r, c, bit);
+        board_->set(r, c, 0); // backtrack
+        ++stats_.backtracks;
+        this->template ascend<Profile>();
+        if constexpr (RecordSteps) steps->push({r, c, 0}); // record removal
+    }
+    restoreEmpty(bestPos);
+    undoTrail<RecordSteps>(mark, steps);
+    return false;
+}
+
+template<int Box>
+bool BasicPropagationEngine<Box>::solve(Board &board, StepSink *steps) {
+    stats_ = {};
+    guessDepth_ = 0;
+    return this->dispatch(steps, [&](auto record, auto profile) {
+        constexpr bool RecordSteps = decltype(record)::value;
+        constexpr bool Profile = decltype(profile)::value;
+        if (!this->template timed<Profile>(stats_.setupTime, [&] { return attach(board); })) return false;
+        return this->template timed<Profile>(stats_.searchTime, [&] { return search<RecordSteps, Profile>(steps); });
+    });
+}
+
+// Same search as above, but keeps going after a solution until limit is reached
+template<int Box>
+std::uint64_t BasicPropagationEngine<Box>::count(std::uint64_t limit) {
+    if (cancelled()) return 0;
+    const int mark = trailSize_;
+    std::uint64_t found = 0;
+    if (propagate<false, false>(nullptr)) {
+        if (emptyCount_ == 0) {
+            found = 1;
+        } else {
+            Mask bestCand = 0;
+            const int bestPos = this->template mostConstrained<false>(bestCand, 2);
+
+            const int cell = empty_[static_cast<size_t>(bestPos)];
+            const int r = cell / SIZE;
+            const int c = cell % SIZE;
+            takeEmpty(bestPos);
+            for (Mask cand = bestCand; cand != 0 && found < limit; cand &= static_cast<Mask>(cand - 1)) {
+                const auto bit = static_cast<Mask>(cand & -cand);
+                board_->set(r, c, std::countr_zero(bit) + 1);
+                flipMasks(r, c, bit);
+                ++stats_.nodes;
+                found += count(limit - found);
+                flipMasks(r, c, bit);
+                board_->set(r, c, 0);
+                ++stats_.backtracks;
+            }
+            restoreEmpty(bestPos);
+        }
+    }
+    undoTrail<false>(mark, nullptr);
+    return found;
+}
+
+template<int Box>
+std::uint64_t BasicPropagationEngine<Box>::countSolutions(const Board &board, std::uint64_t limit) {
+    stats_ = {};
+    Board scratch = board;
+    if (limit == 0 || !attach(scratch)) return 0;
+    const std::uint64_t found = count(limit);
+    board_ = nullptr; // scratch goes out of scope
+    return found;
+}
+
+template class BasicNaiveEngine<2>;
+template class BasicNaiveEngine<3>;
+template class BasicNaiveEngine<4>;
+template class BasicNaiveEngine<5>;
+template class BasicMaskEngine<2>;
+template class BasicMaskEngine<3>;
+template class BasicMaskEngine<4>;
+template class BasicMaskEngine<5>;
+template class BasicBitmaskEngine<2>;
+template class BasicBitmaskEngine<3>;
+template class BasicBitmaskEngine<4>;
+template class BasicBitmaskEngine<5>;
+template class BasicMrvEngine<2>;
+template class BasicMrvEngine<3>;
+template class BasicMrvEngine<4>;
+template class BasicMrvEngine<5>;
+template class BasicPropagationEngine<2>;
+template class BasicPropagationEngine<3>;
+template class BasicPropagationEngine<4>;
+template class BasicPropagationEngine<5>;
@@ -0,0 +1,156 @@
+#include "Canonicalizer.hpp"
+#include <algorithm>
+
+namespace {
+    constexpr std::uint8_t WORST = 0xFF; ///< Larger than any sort key
+
+    /// Cell of the source board as seen through a transposition flag
+    std::uint8_t source(const SudokuBoard &board, const bool transpose, const int row, const int col) {
+        return static_cast<std::uint8_t>(transpose ? board.get(col, row) : board.get(row, col));
+    }
+
+    /// Sort key of a source digit under a (partial) labelling; unlabelled digits take next
+    std::uint8_t key(const std::uint8_t digit, const std::array<std::uint8_t, 10> &labels, const std::uint8_t next) {
+        if (digit == 0) return Canonicalizer::EMPTY_KEY;
+        return labels[digit] != 0 ? labels[digit] : next;
+    }
+}
+
+SudokuBoard BoardTransform::apply(const SudokuBoard &board) const {
+    SudokuBoard image;
+    for (int i = 0; i < 9; ++i)
+        for (int j = 0; j < 9; ++j)
+            image.set(i, j, digits[source(board, transpose, rows[static_cast<std::size_t>(i)], cols[static_cast<std::size_t>(j)])]);
+    return image;
+}
+
+SudokuBoard BoardTransform::invert(const SudokuBoard &board) const {
+    std::array<std::uint8_t, 10> inverse{};
+    for (std::size_t d = 0; d < digits.size(); ++d) inverse[digits[d]] = static_cast<std::uint8_t>(d);
+    SudokuBoard original;
+    for (int i = 0; i < 9; ++i) {
+        for (int j = 0; j < 9; ++j) {
+            const int row = rows[static_cast<std::size_t>(i)];
+            const int col = cols[static_cast<std::size_t>(j)];
+            const int value = inverse[static_cast<std::size_t>(board.get(i, j))];
+            if (transpose)
+                original.set(col, row, value);
+            else
+                original.set(row, col, value);
+        }
+    }
+    return original;
+}
+
+// Depth-first over column orders for the first row: position picks a stack when it
+// starts one, otherwise an unused column of the current stack. The path is compared
+// with the best complete row on every step, which may have changed below a sibling
+void Canonicalizer::firstRow(Candidate &candidate, const int position, const std::uint8_t stacks) {
+    if (current_.size() > MAX_CANDIDATES) return;
+    if (position == 9) {
+        if (path_ < best_) {
+            best_ = path_;
+            current_.clear();
+        }
+        current_.push_back(candidate);
+        return;
+    }
+    const auto at = static_cast<std::size_t>(position);
+    const int stackStart = position - position % 3;
+    const int firstStack = position % 3 == 0 ? 0 : candidate.cols[static_cast<std::size_t>(stackStart)] / 3;
+    const int lastStack = position % 3 == 0 ? 2 : firstStack;
+    for (int stack = firstStack; stack <= lastStack; ++stack) {
+        if (position % 3 == 0 && (stacks & (1U << stack)) != 0) continue;
+        for (int col = stack * 3; col < stack * 3 + 3; ++col) {
+            bool used = false;
+            for (int k = stackStart; k < position; ++k) used |= candidate.cols[static_cast<std::size_t>(k)] == col;
+            if (used) continue;
+
+            const std::uint8_t digit = source(board_, candidate.transpose != 0, candidate.rows[0], col);
+            path_[at] = key(digit, candidate.digits, candidate.next);
+            if (std::lexicographical_compare(best_.begin(), best_.begin() + position + 1, path_.begin(),
+                                             path_.begin() + position + 1))
+                continue; // prefix already larger than the best row
+
+            const bool fresh = digit != 0 && candidate.digits[digit] == 0;
+            if (fresh) candidate.digits[digit] = candidate.next++;
+            candidate.cols[at] = static_cast<std::uint8_t>(col);
+            firstRow(candidate, position + 1, static_cast<std::uint8_t>(stacks | (1U << stack)));
+            if (fresh) {
+                candidate.digits[digit] = 0;
+                --candidate.next;
+            }
+        }
+    }
+}
+
+bool Canonicalizer::canonicalize(const SudokuBoard &board, SudokuBoard &canonical, BoardTransform &transform) {
+    board_ = board;
+
+    // Row 0: every (transpose, source row), every column order
+    current_.clear();
+    best_.fill(WORST);
+    for (std::uint8_t transpose = 0; transpose < 2; ++transpose) {
+        for (std::uint8_t row = 0; row < 9; ++row) {
+            Candidate candidate;
+            candidate.transpose = transpose;
+            candidate.bands = static_cast<std::uint8_t>(1U << (row / 3));
+            candidate.rows[0] = row;
+            firstRow(candidate, 0, 0);
+        }
+    }
+    if (current_.size() > MAX_CANDIDATES) return false;
+
+    // Rows 1-8: extend every tie by every allowed source row, keep the smallest
+    for (int row = 1; row < 9; ++row) {
+        next_.clear();
+        best_.fill(WORST);
+        for (const Candidate &candidate: current_) {
+            const bool newBand = row % 3 == 0;
+            const int band = candidate.rows[static_cast<std::size_t>(row - 1)] / 3;
+            for (int src = 0; src < 9; ++src) {
+                if (newBand ? (candidate.bands & (1U << (src / 3))) != 0 : src / 3 != band) continue;
+                bool used = false;
+                for (int k = row - row % 3; k < row; ++k) used |= candidate.rows[static_cast<std::size_t>(k)] == src;
+                if (used) continue;
+
+                // Compare key by key, abandoning as soon as the row is larger
+                Candidate extended = candidate;
+                bool less = false;
+                bool larger = false;
+                std::array<std::uint8_t, 9> keys{};
+                for (std::size_t j = 0; j < 9 && !larger; ++j) {
+                    const std::uint8_t digit = source(board_, extended.transpose != 0, src, extended.cols[j]);
+                    keys[j] = key(digit, extended.digits, extended.next);
+                    if (digit != 0 && extended.digits[digit] == 0) extended.digits[digit] = extended.next++;
+                    if (!less) {
+                        larger = keys[j] > best_[j];
+                        less = keys[j] < best_[j];
+                    }
+                }
+                if (larger) continue;
+                if (less) {
+                    next_.clear();
+                    best_ = keys;
+                }
+                extended.rows[static_cast<std::size_t>(row)] = static_cast<std::uint8_t>(src);
+                extended.bands = static_cast<std::uint8_t>(extended.bands | (1U << (src / 3)));
+                next_.push_back(extended);
+                if (next_.size() > MAX_CANDIDATES) return false;
+            }
+        }
+        current_.swap(next_);
+    }
+
+    // Any survivor yields the minimum; digits missing from the board take the spare labels
+    const Candidate &winner = current_.front();
+    transform.transpose = winner.transpose != 0;
+    transform.rows = winner.rows;
+    transform.cols = winner.cols;
+    transform.digits = winner.digits;
+    std::uint8_t next = winner.next;
+    for (std::size_t d = 1; d < transform.digits.size(); ++d)
+        if (transform.digits[d] == 0) transform.digits[d] = next++;
+    canonical = transform.apply(board);
+    return true;
+}
@@ -0,0 +1,25 @@
+#include "CompactTrace.hpp"
+
+template<int Box>
+void BasicCompactTrace<Box>::push(const SolveStep &step) {
+    const Code code = encode(step);
+    ++steps_;
+
+    // A removal of the cell placed by the previous code turns that code into a bounce
+    if (coalesce_ && step.value == 0 && !codes_.empty()) {
+        Code &last = codes_.back();
+        const bool sameCell = (last & CELL_MASK) == (code & CELL_MASK);
+        const bool sameKind = (last & DEDUCED_BIT) == (code & DEDUCED_BIT);
+        const bool placement = ((last >> VALUE_SHIFT) & VALUE_MASK) != 0;
+        if (sameCell && sameKind && placement && (last & BOUNCE_BIT) == 0) {
+            last |= BOUNCE_BIT;
+            return;
+        }
+    }
+    codes_.push_back(code);
+}
+
+template class BasicCompactTrace<2>;
+template class BasicCompactTrace<3>;
+template class BasicCompactTrace<4>;
+template class BasicCompactTrace<5>;
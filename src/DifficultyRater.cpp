@@ -0,0 +1,416 @@
+#include "DifficultyRater.hpp"
+#include <bit>
+#include <bitset>
+
+namespace {
+    using Mask = DifficultyRater::Mask;
+    constexpr Mask ALL = 0x1FF; ///< Nine digits, or nine positions of a unit
+    constexpr int ROWS = 0; ///< First row unit
+    constexpr int COLS = 9; ///< First column unit
+    constexpr int BOXES = 18; ///< First box unit
+
+    /// Cell/unit incidence, built once
+    struct Geometry {
+        std::array<std::array<int, 9>, 27> cells{}; ///< [unit][position] = cell
+        std::array<std::array<int, 3>, 81> units{}; ///< [cell] = row, column and box unit
+        std::array<std::array<int, 3>, 81> pos{}; ///< [cell][k] = position of the cell in units[cell][k]
+        std::array<std::array<int, 20>, 81> peers{}; ///< Cells sharing a unit
+        std::array<std::bitset<81>, 81> sees{}; ///< peers as a set
+    };
+
+    const Geometry G = [] {
+        Geometry g;
+        for (int cell = 0; cell < 81; ++cell) {
+            const int row = cell / 9;
+            const int col = cell % 9;
+            const int box = row / 3 * 3 + col / 3;
+            const auto c = static_cast<std::size_t>(cell);
+            g.units[c] = {ROWS + row, COLS + col, BOXES + box};
+            g.pos[c] = {col, row, row % 3 * 3 + col % 3};
+            for (std::size_t k = 0; k < 3; ++k)
+                g.cells[static_cast<std::size_t>(g.units[c][k])][static_cast<std::size_t>(g.pos[c][k])] = cell;
+        }
+        for (std::size_t c = 0; c < 81; ++c) {
+            for (const int unit: g.units[c])
+                for (const int other: g.cells[static_cast<std::size_t>(unit)])
+                    if (static_cast<std::size_t>(other) != c) g.sees[c].set(static_cast<std::size_t>(other));
+            std::size_t n = 0;
+            for (std::size_t other = 0; other < 81; ++other)
+                if (g.sees[c].test(other)) g.peers[c][n++] = static_cast<int>(other);
+        }
+        return g;
+    }();
+
+    constexpr Mask bit(const int index) { return static_cast<Mask>(1U << index); }
+    int lowest(const Mask mask) { return std::countr_zero(mask); }
+    int count(const Mask mask) { return std::popcount(mask); }
+    const std::array<int, 9> &cellsOf(const int unit) { return G.cells[static_cast<std::size_t>(unit)]; }
+    bool sees(const int a, const int b) { return G.sees[static_cast<std::size_t>(a)].test(static_cast<std::size_t>(b)); }
+
+    /**
+     * @brief Visit every size-element subset (2 or 3) of picked indices
+     * @param picked Indices to choose from (first n used)
+     * @param n Number of picked indices
+     * @param size Subset size
+     * @param visit Called with the subset as a bit mask; returning true stops the search
+     * @return true if visit returned true
+     */
+    template<typename Visit>
+    bool anySubset(const std::array<int, 9> &picked, const int n, const int size, Visit &&visit) {
+        const auto at = [&](const int i) { return bit(picked[static_cast<std::size_t>(i)]); };
+        for (int a = 0; a < n; ++a) {
+            for (int b = a + 1; b < n; ++b) {
+                if (size == 2) {
+                    if (visit(static_cast<Mask>(at(a) | at(b)))) return true;
+                    continue;
+                }
+                for (int c = b + 1; c < n; ++c)
+                    if (visit(static_cast<Mask>(at(a) | at(b) | at(c)))) return true;
+            }
+        }
+        return false;
+    }
+
+    constexpr std::array<double, TECHNIQUE_COUNT> SCORES = {1.5, 2.3, 2.6, 2.8, 3.0, 3.2, 3.4, 3.6, 3.8, 4.0, 4.2, 5.0, 10.0};
+    constexpr std::array<std::string_view, TECHNIQUE_COUNT> TECHNIQUE_NAMES = {
+        "Hidden Single", "Naked Single", "Pointing", "Claiming", "Naked Pair", "X-Wing", "Hidden Pair",
+        "Naked Triple", "Swordfish", "Hidden Triple", "XY-Wing", "XY-Chain", "Trial and Error"};
+    constexpr std::array<std::string_view, DIFFICULTY_COUNT> DIFFICULTY_NAMES = {
+        "Easy", "Medium", "Hard", "Expert", "Extreme"};
+}
+
+double DifficultyRater::score(const Technique technique) {
+    return SCORES[static_cast<std::size_t>(technique)];
+}
+
+Difficulty DifficultyRater::difficulty(const Technique technique) {
+    if (technique <= Technique::NakedSingle) return Difficulty::Easy;
+    if (technique <= Technique::NakedPair) return Difficulty::Medium;
+    if (technique <= Technique::XYWing) return Difficulty::Hard;
+    if (technique <= Technique::XYChain) return Difficulty::Expert;
+    return Difficulty::Extreme;
+}
+
+std::string_view DifficultyRater::name(const Technique technique) {
+    return TECHNIQUE_NAMES[static_cast<std::size_t>(technique)];
+}
+
+std::string_view DifficultyRater::name(const Difficulty difficulty) {
+    return DIFFICULTY_NAMES[static_cast<std::size_t>(difficulty)];
+}
+
+SudokuBoard DifficultyRater::board() const {
+    SudokuBoard result;
+    result.cells = values_;
+    return result;
+}
+
+// Drops every other candidate of the cell, then the digit from all peers
+void DifficultyRater::place(const int cell, const int digit) {
+    const auto c = static_cast<std::size_t>(cell);
+    const Mask own = bit(digit - 1);
+    if ((cand_[c] & own) == 0) {
+        broken_ = true;
+        return;
+    }
+    values_[c] = static_cast<std::uint8_t>(digit);
+    --open_;
+    for (std::size_t k = 0; k < 3; ++k) {
+        const auto unit = static_cast<std::size_t>(G.units[c][k]);
+        placed_[unit] |= own;
+        places_[unit][static_cast<std::size_t>(digit - 1)] = 0;
+    }
+    for (Mask rest = cand_[c] & static_cast<Mask>(~own); rest != 0; rest &= static_cast<Mask>(rest - 1)) {
+        const auto d = static_cast<std::size_t>(lowest(rest));
+        for (std::size_t k = 0; k < 3; ++k) {
+            const auto unit = static_cast<std::size_t>(G.units[c][k]);
+            places_[unit][d] &= static_cast<Mask>(~bit(G.pos[c][k]));
+            if (places_[unit][d] == 0 && (placed_[unit] & bit(static_cast<int>(d))) == 0) broken_ = true;
+        }
+    }
+    cand_[c] = 0;
+    for (const int peer: G.peers[c]) eliminate(peer, digit);
+}
+
+bool DifficultyRater::eliminate(const int cell, const int digit) {
+    const auto c = static_cast<std::size_t>(cell);
+    const Mask own = bit(digit - 1);
+    if ((cand_[c] & own) == 0) return false;
+    cand_[c] &= static_cast<Mask>(~own);
+    if (cand_[c] == 0) broken_ = true;
+    const auto d = static_cast<std::size_t>(digit - 1);
+    for (std::size_t k = 0; k < 3; ++k) {
+        const auto unit = static_cast<std::size_t>(G.units[c][k]);
+        places_[unit][d] &= static_cast<Mask>(~bit(G.pos[c][k]));
+        if (places_[unit][d] == 0 && (placed_[unit] & own) == 0) broken_ = true;
+    }
+    return true;
+}
+
+bool DifficultyRater::hiddenSingles() {
+    bool progress = false;
+    for (int unit = 0; unit < 27; ++unit) {
+        for (int d = 0; d < 9; ++d) {
+            const Mask where = places_[static_cast<std::size_t>(unit)][static_cast<std::size_t>(d)];
+            if (count(where) != 1) continue;
+            place(cellsOf(unit)[static_cast<std::size_t>(lowest(where))], d + 1);
+            progress = true;
+        }
+    }
+    return progress;
+}
+
+bool DifficultyRater::nakedSingles() {
+    bool progress = false;
+    for (int cell = 0; cell < 81; ++cell) {
+        const Mask mask = cand_[static_cast<std::size_t>(cell)];
+        if (count(mask) != 1) continue;
+        place(cell, lowest(mask) + 1);
+        progress = true;
+    }
+    return progress;
+}
+
+// Box positions are row * 3 + col, so a box row is 0x7 << 3k and a box column 0x49 << k
+bool DifficultyRater::pointing() {
+    for (int box = 0; box < 9; ++box) {
+        for (int d = 0; d < 9; ++d) {
+            const Mask where = places_[static_cast<std::size_t>(BOXES + box)][static_cast<std::size_t>(d)];
+            if (where == 0) continue;
+            for (int k = 0; k < 3; ++k) {
+                bool progress = false;
+                if ((where & ~(0x7 << (3 * k))) == 0) {
+                    for (const int cell: cellsOf(ROWS + box / 3 * 3 + k))
+                        if (cell % 9 / 3 != box % 3) progress |= eliminate(cell, d + 1);
+                } else if ((where & ~(0x49 << k)) == 0) {
+                    for (const int cell: cellsOf(COLS + box % 3 * 3 + k))
+                        if (cell / 27 != box / 3) progress |= eliminate(cell, d + 1);
+                }
+                if (progress) return true;
+            }
+        }
+    }
+    return false;
+}
+
+// Row and column positions run 0-8, so a box segment is 0x7 << 3k
+bool DifficultyRater::claiming() {
+    for (int line = 0; line < 18; ++line) {
+        for (int d = 0; d < 9; ++d) {
+            const Mask where = places_[static_cast<std::size_t>(line)][static_cast<std::size_t>(d)];
+            if (where == 0) continue;
+            for (int k = 0; k < 3; ++k) {
+                if ((where & ~(0x7 << (3 * k))) != 0) continue;
+                const bool isRow = line < COLS;
+                const int index = isRow ? line : line - COLS;
+                const int box = isRow ? index / 3 * 3 + k : k * 3 + index / 3;
+                bool progress = false;
+                for (const int cell: cellsOf(BOXES + box))
+                    if ((isRow ? cell / 9 : cell % 9) != index) progress |= eliminate(cell, d + 1);
+                if (progress) return true;
+            }
+        }
+    }
+    return false;
+}
+
+// size cells of a unit holding only size digits between them own those digits
+bool DifficultyRater::nakedSubset(const int size) {
+    for (int unit = 0; unit < 27; ++unit) {
+        const auto &cells = cellsOf(unit);
+        std::array<int, 9> picked{};
+        int n = 0;
+        for (int p = 0; p < 9; ++p) {
+            const int k = count(cand_[static_cast<std::size_t>(cells[static_cast<std::size_t>(p)])]);
+            if (k >= 2 && k <= size) picked[static_cast<std::size_t>(n++)] = p;
+        }
+        const bool progress = anySubset(picked, n, size, [&](const Mask positions) {
+            Mask digits = 0;
+            for (Mask m = positions; m != 0; m &= static_cast<Mask>(m - 1))
+                digits |= cand_[static_cast<std::size_t>(cells[static_cast<std::size_t>(lowest(m))])];
+            if (count(digits) != size) return false;
+            bool changed = false;
+            for (int p = 0; p < 9; ++p) {
+                if ((positions & bit(p)) != 0) continue;
+                for (Mask m = digits; m != 0; m &= static_cast<Mask>(m - 1))
+                    changed |= eliminate(cells[static_cast<std::size_t>(p)], lowest(m) + 1);
+            }
+            return changed;
+        });
+        if (progress) return true;
+    }
+    return false;
+}
+
+// size digits confined to size cells of a unit leave no room for other digits there
+bool DifficultyRater::hiddenSubset(const int size) {
+    for (int unit = 0; unit < 27; ++unit) {
+        const auto &where = places_[static_cast<std::size_t>(unit)];
+        std::array<int, 9> picked{};
+        int n = 0;
+        for (int d = 0; d < 9; ++d) {
+            const int k = count(where[static_cast<std::size_t>(d)]);
+            if (k >= 2 && k <= size) picked[static_cast<std::size_t>(n++)] = d;
+        }
+        const bool progress = anySubset(picked, n, size, [&](const Mask digits) {
+            Mask positions = 0;
+            for (Mask m = digits; m != 0; m &= static_cast<Mask>(m - 1))
+                positions |= where[static_cast<std::size_t>(lowest(m))];
+            if (count(positions) != size) return false;
+            bool changed = false;
+            for (Mask p = positions; p != 0; p &= static_cast<Mask>(p - 1)) {
+                const int cell = cellsOf(unit)[static_cast<std::size_t>(lowest(p))];
+                for (Mask m = cand_[static_cast<std::size_t>(cell)] & static_cast<Mask>(~digits); m != 0;
+                     m &= static_cast<Mask>(m - 1))
+                    changed |= eliminate(cell, lowest(m) + 1);
+            }
+            return changed;
+        });
+        if (progress) return true;
+    }
+    return false;
+}
+
+// size base lines whose digit positions cover only size cross lines clear those cross lines
+bool DifficultyRater::fish(const int size) {
+    for (int d = 0; d < 9; ++d) {
+        for (const int base: {ROWS, COLS}) {
+            const int cover = base == ROWS ? COLS : ROWS;
+            std::array<int, 9> picked{};
+            int n = 0;
+            for (int line = 0; line < 9; ++line) {
+                const int k = count(places_[static_cast<std::size_t>(base + line)][static_cast<std::size_t>(d)]);
+                if (k >= 2 && k <= size) picked[static_cast<std::size_t>(n++)] = line;
+            }
+            const bool progress = anySubset(picked, n, size, [&](const Mask lines) {
+                Mask crosses = 0;
+                for (Mask m = lines; m != 0; m &= static_cast<Mask>(m - 1))
+                    crosses |= places_[static_cast<std::size_t>(base + lowest(m))][static_cast<std::size_t>(d)];
+                if (count(crosses) != size) return false;
+                bool changed = false;
+                for (Mask m = crosses; m != 0; m &= static_cast<Mask>(m - 1)) {
+                    const auto &cells = cellsOf(cover + lowest(m));
+                    for (int p = 0; p < 9; ++p)
+                        if ((lines & bit(p)) == 0) changed |= eliminate(cells[static_cast<std::size_t>(p)], d + 1);
+                }
+                return changed;
+            });
+            if (progress) return true;
+        }
+    }
+    return false;
+}
+
+// Pivot {x,y}, pincers {x,z} and {y,z}: whichever the pivot holds, one pincer is z
+bool DifficultyRater::xyWing() {
+    for (int pivot = 0; pivot < 81; ++pivot) {
+        const Mask xy = cand_[static_cast<std::size_t>(pivot)];
+        if (count(xy) != 2) continue;
+        const auto &peers = G.peers[static_cast<std::size_t>(pivot)];
+        for (const int a: peers) {
+            const Mask xz = cand_[static_cast<std::size_t>(a)];
+            if (count(xz) != 2 || count(static_cast<Mask>(xz & xy)) != 1) continue;
+            const Mask z = xz & static_cast<Mask>(~xy);
+            const Mask yz = static_cast<Mask>((xy & ~xz) | z);
+            for (const int b: peers) {
+                if (cand_[static_cast<std::size_t>(b)] != yz) continue;
+                bool progress = false;
+                const auto both = G.sees[static_cast<std::size_t>(a)] & G.sees[static_cast<std::size_t>(b)];
+                for (int cell = 0; cell < 81; ++cell)
+                    if (both.test(static_cast<std::size_t>(cell))) progress |= eliminate(cell, lowest(z) + 1);
+                if (progress) return true;
+            }
+        }
+    }
+    return false;
+}
+
+// Breadth-first over bivalue cells: if start is not z its other digit is on, each link
+// turns the shared digit off in the next cell; reaching a cell whose on digit is z means
+// one of the two ends is z, so cells seeing both ends are not
+bool DifficultyRater::xyChain() {
+    std::array<int, 81 * 9> queue{};
+    std::array<Mask, 81> seen{};
+    for (int start = 0; start < 81; ++start) {
+        const Mask pair = cand_[static_cast<std::size_t>(start)];
+        if (count(pair) != 2) continue;
+        for (Mask zs = pair; zs != 0; zs &= static_cast<Mask>(zs - 1)) {
+            const int z = lowest(zs);
+            seen.fill(0);
+            std::size_t head = 0;
+            std::size_t tail = 0;
+            const int first = lowest(static_cast<Mask>(pair & ~bit(z)));
+            queue[tail++] = start * 9 + first;
+            seen[static_cast<std::size_t>(start)] = bit(first);
+            while (head < tail) {
+                const int cell = queue[head] / 9;
+                const int on = queue[head] % 9;
+                ++head;
+                for (const int next: G.peers[static_cast<std::size_t>(cell)]) {
+                    const Mask link = cand_[static_cast<std::size_t>(next)];
+                    if (next == start || count(link) != 2 || (link & bit(on)) == 0) continue;
+                    const int nextOn = lowest(static_cast<Mask>(link & ~bit(on)));
+                    auto &visited = seen[static_cast<std::size_t>(next)];
+                    if ((visited & bit(nextOn)) != 0) continue;
+                    visited |= bit(nextOn);
+                    if (nextOn == z) {
+                        bool progress = false;
+                        for (int other = 0; other < 81; ++other)
+                            if (other != start && other != next && sees(other, start) && sees(other, next))
+                                progress |= eliminate(other, z + 1);
+                        if (progress) return true;
+                    }
+                    queue[tail++] = next * 9 + nextOn;
+                }
+            }
+        }
+    }
+    return false;
+}
+
+bool DifficultyRater::apply(const Technique technique) {
+    switch (technique) {
+        case Technique::HiddenSingle: return hiddenSingles();
+        case Technique::NakedSingle: return nakedSingles();
+        case Technique::Pointing: return pointing();
+        case Technique::Claiming: return claiming();
+        case Technique::NakedPair: return nakedSubset(2);
+        case Technique::XWing: return fish(2);
+        case Technique::HiddenPair: return hiddenSubset(2);
+        case Technique::NakedTriple: return nakedSubset(3);
+        case Technique::Swordfish: return fish(3);
+        case Technique::HiddenTriple: return hiddenSubset(3);
+        case Technique::XYWing: return xyWing();
+        case Technique::XYChain: return xyChain();
+        case Technique::Trial: break;
+    }
+    return false;
+}
+
+Rating DifficultyRater::rate(const SudokuBoard &puzzle) {
+    values_.fill(0);
+    cand_.fill(ALL);
+    for (auto &unit: places_) unit.fill(ALL);
+    placed_.fill(0);
+    open_ = SudokuBoard::CELLS;
+    broken_ = false;
+    for (int cell = 0; cell < SudokuBoard::CELLS && !broken_; ++cell) {
+        const int digit = puzzle.cells[static_cast<std::size_t>(cell)];
+        if (digit != 0) place(cell, digit);
+    }
+
+    Rating rating;
+    while (!broken_ && open_ > 0) {
+        auto technique = Technique::HiddenSingle;
+        while (technique != Technique::Trial && !apply(technique))
+            technique = static_cast<Technique>(static_cast<int>(technique) + 1);
+        ++rating.uses[static_cast<std::size_t>(technique)];
+        if (technique > rating.hardest) rating.hardest = technique;
+        if (technique == Technique::Trial) break;
+    }
+    rating.valid = !broken_;
+    rating.solved = rating.valid && open_ == 0;
+    rating.score = score(rating.hardest);
+    rating.difficulty = difficulty(rating.hardest);
+    return rating;
+}
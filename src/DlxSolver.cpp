@@ -0,0 +1,197 @@
+#include "DlxSolver.hpp"
+
+// Build header ring and the 729 candidate rows
+DlxSolver::DlxSolver() {
+    for (int h = 0; h <= COLUMNS; ++h) {
+        const auto i = static_cast<size_t>(h);
+        left_[i] = (h == 0) ? COLUMNS : h - 1;
+        right_[i] = (h == COLUMNS) ? 0 : h + 1;
+        up_[i] = h;
+        down_[i] = h;
+        column_[i] = h;
+    }
+
+    for (int id = 0; id < ROWS; ++id) {
+        const int cell = id / 9;
+        const int digit = id % 9;
+        const int r = cell / 9;
+        const int c = cell % 9;
+        const int b = (r / 3) * 3 + c / 3;
+        const std::array<int, 4> cols = {
+            cell, // each cell holds one digit
+            81 + r * 9 + digit, // each row holds each digit once
+            162 + c * 9 + digit, // each column holds each digit once
+            243 + b * 9 + digit // each box holds each digit once
+        };
+
+        const int base = rowNode(id);
+        for (int k = 0; k < 4; ++k) {
+            const int n = base + k;
+            const int h = cols[static_cast<size_t>(k)] + 1;
+            const auto ni = static_cast<size_t>(n);
+            const auto hi = static_cast<size_t>(h);
+            column_[ni] = h;
+            rowOf_[ni] = id;
+            // Append at the bottom of column h
+            up_[ni] = up_[hi];
+            down_[ni] = h;
+            down_[static_cast<size_t>(up_[hi])] = n;
+            up_[hi] = n;
+            ++size_[hi];
+            // Circular row ring
+            left_[ni] = base + (k + 3) % 4;
+            right_[ni] = base + (k + 1) % 4;
+        }
+    }
+}
+
+void DlxSolver::cover(int c) {
+    const auto ci = static_cast<size_t>(c);
+    right_[static_cast<size_t>(left_[ci])] = right_[ci];
+    left_[static_cast<size_t>(right_[ci])] = left_[ci];
+    for (int i = down_[ci]; i != c; i = down_[static_cast<size_t>(i)]) {
+        for (int j = right_[static_cast<size_t>(i)]; j != i; j = right_[static_cast<size_t>(j)]) {
+            const auto ji = static_cast<size_t>(j);
+            up_[static_cast<size_t>(down_[ji])] = up_[ji];
+            down_[static_cast<size_t>(up_[ji])] = down_[ji];
+            --size_[static_cast<size_t>(column_[ji])];
+        }
+    }
+}
+
+void DlxSolver::uncover(int c) {
+    const auto ci = static_cast<size_t>(c);
+    for (int i = up_[ci]; i != c; i = up_[static_cast<size_t>(i)]) {
+        for (int j = left_[static_cast<size_t>(i)]; j != i; j = left_[static_cast<size_t>(j)]) {
+            const auto ji = static_cast<size_t>(j);
+            ++size_[static_cast<size_t>(column_[ji])];
+            up_[static_cast<size_t>(down_[ji])] = j;
+            down_[static_cast<size_t>(up_[ji])] = j;
+        }
+    }
+    right_[static_cast<size_t>(left_[ci])] = c;
+    left_[static_cast<size_t>(right_[ci])] = c;
+}
+
+template<bool Profile>
+bool DlxSolver::search(StepSink *steps) {
+    if (cancelled()) return false;
+    if (right_[ROOT] == ROOT) return true; // every constraint satisfied
+
+    // S heuristic: column with the fewest remaining rows
+    int best = right_[ROOT];
+    for (int h = right_[static_cast<size_t>(best)]; h != ROOT; h = right_[static_cast<size_t>(h)]) {
+        tally<Profile>(stats_.candidateTests);
+        if (size_[static_cast<size_t>(h)] < size_[static_cast<size_t>(best)]) best = h;
+    }
+    if (size_[static_cast<size_t>(best)] == 0) return false; // dead end -> backtrack
+
+    cover(best);
+    for (int r = down_[static_cast<size_t>(best)]; r != best; r = down_[static_cast<size_t>(r)]) {
+        const int id = rowOf_[static_cast<size_t>(r)];
+        ++stats_.nodes;
+        if (steps != nullptr) steps->push({id / 81, (id / 9) % 9, id % 9 + 1}); // record placement
+        solution_[static_cast<size_t>(depth_++)] = r;
+        if constexpr (Profile) stats_.maxDepth = std::max(stats_.maxDepth, depth_);
+        for (int j = right_[static_cast<size_t>(r)]; j != r; j = right_[static_cast<size_t>(j)])
+            cover(column_[static_cast<size_t>(j)]);
+
+        const bool found = search<Profile>(steps);
+
+        // Always unwind so the structure is pristine for the next puzzle
+        for (int j = left_[static_cast<size_t>(r)]; j != r; j = left_[static_cast<size_t>(j)])
+            uncover(column_[static_cast<size_t>(j)]);
+        if (found) {
+            uncover(best);
+            return true;
+        }
+        --depth_;
+        ++stats_.backtracks;
+        if (steps != nullptr) steps->push({id / 81, (id / 9) % 9, 0}); // record removal
+    }
+    uncover(best);
+    return false;
+}
+
+std::uint64_t DlxSolver::count(std::uint64_t limit) {
+    if (cancelled()) return 0;
+    if (right_[ROOT] == ROOT) return 1;
+
+    int best = right_[ROOT];
+    for (int h = right_[static_cast<size_t>(best)]; h != ROOT; h = right_[static_cast<size_t>(h)])
+        if (size_[static_cast<size_t>(h)] < size_[static_cast<size_t>(best)]) best = h;
+    if (size_[static_cast<size_t>(best)] == 0) return 0;
+
+    std::uint64_t found = 0;
+    cover(best);
+    for (int r = down_[static_cast<size_t>(best)]; r != best && found < limit; r = down_[static_cast<size_t>(r)]) {
+        ++stats_.nodes;
+        for (int j = right_[static_cast<size_t>(r)]; j != r; j = right_[static_cast<size_t>(j)])
+            cover(column_[static_cast<size_t>(j)]);
+        found += count(limit - found);
+        for (int j = left_[static_cast<size_t>(r)]; j != r; j = left_[static_cast<size_t>(j)])
+            uncover(column_[static_cast<size_t>(j)]);
+        ++stats_.backtracks;
+    }
+    uncover(best);
+    return found;
+}
+
+// Select the rows of filled cells; a covered column or a value above 9 means bad givens
+bool DlxSolver::coverGivens(const SudokuBoard &board) {
+    givenCount_ = 0;
+    for (int cell = 0; cell < 81; ++cell) {
+        const int val = board.cells[static_cast<size_t>(cell)];
+        if (val == 0) continue;
+        if (val > SudokuBoard::SIZE) return false; // would select another cell's row, or run past the nodes
+        const int n = rowNode(cell * 9 + val - 1);
+        for (int j = n, k = 0; k < 4; j = right_[static_cast<size_t>(j)], ++k)
+            if (covered_[static_cast<size_t>(column_[static_cast<size_t>(j)])]) return false;
+        for (int j = n, k = 0; k < 4; j = right_[static_cast<size_t>(j)], ++k) {
+            const int h = column_[static_cast<size_t>(j)];
+            cover(h);
+            covered_[static_cast<size_t>(h)] = true;
+        }
+        givens_[static_cast<size_t>(givenCount_++)] = n;
+    }
+    return true;
+}
+
+void DlxSolver::uncoverGivens() {
+    while (givenCount_ > 0) {
+        const int n = givens_[static_cast<size_t>(--givenCount_)];
+        for (int j = left_[static_cast<size_t>(n)], k = 0; k < 4; j = left_[static_cast<size_t>(j)], ++k) {
+            const int h = column_[static_cast<size_t>(j)];
+            uncover(h);
+            covered_[static_cast<size_t>(h)] = false;
+        }
+    }
+}
+
+bool DlxSolver::solve(SudokuBoard &board, StepSink *steps) {
+    stats_ = {};
+    depth_ = 0;
+
+    // Steps are checked at runtime here, so only the profiling flag is a template argument
+    const bool solved = dispatch(nullptr, [&](auto, auto profile) {
+        constexpr bool Profile = decltype(profile)::value;
+        const bool consistent = timed<Profile>(stats_.setupTime, [&] { return coverGivens(board); });
+        return consistent && timed<Profile>(stats_.searchTime, [&] { return search<Profile>(steps); });
+    });
+    if (solved) {
+        for (int i = 0; i < depth_; ++i) {
+            const int id = rowOf_[static_cast<size_t>(solution_[static_cast<size_t>(i)])];
+            board.cells[static_cast<size_t>(id / 9)] = static_cast<std::uint8_t>(id % 9 + 1);
+        }
+    }
+
+    uncoverGivens();
+    return solved;
+}
+
+std::uint64_t DlxSolver::countSolutions(const SudokuBoard &board, std::uint64_t limit) {
+    stats_ = {};
+    const std::uint64_t found = limit > 0 && coverGivens(board) ? count(limit) : 0;
+    uncoverGivens();
+    return found;
+}
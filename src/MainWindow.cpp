@@ -1,124 +1,332 @@
 #include "MainWindow.hpp"
 #include "ui_MainWindow.h"
+#include <QDir>
 #include <QElapsedTimer>
-#include <random>
-
-// Puzzle Collection - 5 example puzzles
-const std::vector<std::vector<std::vector<int>>> MainWindow::PUZZLES = {
-    // ...existing puzzles...
-    {
-        {8, 0, 0, 0, 0, 0, 0, 0, 0},
-        {0, 0, 3, 6, 0, 0, 0, 0, 0},
-        {0, 7, 0, 0, 9, 0, 2, 0, 0},
-        {0, 5, 0, 0, 0, 7, 0, 0, 0},
-        {0, 0, 0, 0, 4, 5, 7, 0, 0},
-        {0, 0, 0, 1, 0, 0, 0, 3, 0},
-        {0, 0, 1, 0, 0, 0, 0, 6, 8},
-        {0, 0, 8, 5, 0, 0, 0, 1, 0},
-        {0, 9, 0, 0, 0, 0, 4, 0, 0}},
-    {{5, 3, 0, 0, 7, 0, 0, 0, 0},
-     {6, 0, 0, 1, 9, 5, 0, 0, 0},
-     {0, 9, 8, 0, 0, 0, 0, 6, 0},
-     {8, 0, 0, 0, 6, 0, 0, 0, 3},
-     {4, 0, 0, 8, 0, 3, 0, 0, 1},
-     {7, 0, 0, 0, 2, 0, 0, 0, 6},
-     {0, 6, 0, 0, 0, 0, 2, 8, 0},
-     {0, 0, 0, 4, 1, 9, 0, 0, 5},
-     {0, 0, 0, 0, 8, 0, 0, 7, 9}},
-    {{0, 0, 0, 2, 6, 0, 7, 0, 1},
-     {6, 8, 0, 0, 7, 0, 0, 9, 0},
-     {1, 9, 0, 0, 0, 4, 5, 0, 0},
-     {8, 2, 0, 1, 0, 0, 0, 4, 0},
-     {0, 0, 4, 6, 0, 2, 9, 0, 0},
-     {0, 5, 0, 0, 0, 3, 0, 2, 8},
-     {0, 0, 9, 3, 0, 0, 0, 7, 4},
-     {0, 4, 0, 0, 5, 0, 0, 3, 6},
-     {7, 0, 3, 0, 1, 8, 0, 0, 0}},
-    {{0, 0, 0, 0, 0, 0, 0, 0, 0},
-     {0, 0, 0, 0, 0, 3, 0, 8, 5},
-     {0, 0, 1, 0, 2, 0, 0, 0, 0},
-     {0, 0, 0, 5, 0, 7, 0, 0, 0},
-     {0, 0, 4, 0, 0, 0, 1, 0, 0},
-     {0, 9, 0, 0, 0, 0, 0, 0, 0},
-     {5, 0, 0, 0, 0, 0, 0, 7, 3},
-     {0, 0, 2, 0, 1, 0, 0, 0, 0},
-     {0, 0, 0, 0, 4, 0, 0, 0, 9}},
-    {{0, 2, 0, 0, 0, 0, 0, 0, 0},
-     {0, 0, 0, 6, 0, 0, 0, 0, 3},
-     {0, 7, 4, 0, 8, 0, 0, 0, 0},
-     {0, 0, 0, 0, 0, 3, 0, 0, 2},
-     {0, 8, 0, 0, 4, 0, 0, 1, 0},
-     {6, 0, 0, 5, 0, 0, 0, 0, 0},
-     {0, 0, 0, 0, 1, 0, 7, 8, 0},
-     {5, 0, 0, 0, 0, 9, 0, 0, 0},
-     {0, 0, 0, 0, 0, 0, 0, 4, 0}}};
+#include <QFile>
+#include <QFileDialog>
+#include <QFileInfo>
+#include <QSignalBlocker>
+#include <QStandardPaths>
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <optional>
+#include <thread>
+
+namespace
+{
+    /// Cell values of a board as the byte array carried by solveFinished
+    template<int Box>
+    QByteArray toBytes(const BasicBoard<Box> &board)
+    {
+        return QByteArray(reinterpret_cast<const char *>(board.cells.data()), BasicBoard<Box>::CELLS);
+    }
+
+    /// Inverse of toBytes()
+    template<int Box>
+    BasicBoard<Box> fromBytes(const QByteArray &bytes)
+    {
+        BasicBoard<Box> board;
+        std::memcpy(board.cells.data(), bytes.constData(), board.cells.size());
+        return board;
+    }
+
+    /// Current values of the grid, whatever its size
+    QByteArray gridBytes(const SudokuGrid &grid)
+    {
+        return withBoxSize(grid.boxSize(), [&](auto size) {
+            return toBytes(grid.currentBoard<decltype(size)::value>());
+        });
+    }
+}
 
 // Constructor - Initialize UI and connect signals
 MainWindow::MainWindow(QWidget *parent)
     : QMainWindow(parent), ui_(std::make_unique<Ui::MainWindow>())
 {
     ui_->setupUi(this);
+    playback_ = Playback::create(ui_->grid->boxSize());
 
     // Set up animation timer for 60 FPS
     animTimer_ = new QTimer(this);
     animTimer_->setInterval(16); // 60 FPS (16ms per frame)
     connect(animTimer_, &QTimer::timeout, this, &MainWindow::onAnimStep);
 
+    // Solver engines selectable at runtime, straight from the registry (item data = EngineKind)
+    for (const auto &engine: SolverRegistry::engines())
+        ui_->engineCombo->addItem(QString::fromUtf8(engine.label.data(), static_cast<qsizetype>(engine.label.size())),
+                                  static_cast<int>(engine.kind));
+    ui_->engineCombo->setCurrentIndex(ui_->engineCombo->findData(static_cast<int>(EngineKind::Propagation)));
+
+    // Difficulty buckets of new puzzles (item data = Difficulty, -1 = clue count only)
+    ui_->difficultyCombo->addItem("Any difficulty", -1);
+    for (std::size_t i = 0; i < DIFFICULTY_COUNT; ++i)
+    {
+        const std::string_view name = DifficultyRater::name(static_cast<Difficulty>(i));
+        ui_->difficultyCombo->addItem(QString::fromUtf8(name.data(), static_cast<qsizetype>(name.size())),
+                                      static_cast<int>(i));
+    }
+    connect(ui_->difficultyCombo, &QComboBox::currentIndexChanged, this, &MainWindow::updateSizeControls);
+
+    // Board sizes (item data = box side)
+    for (int box = 2; box <= 5; ++box)
+        ui_->sizeCombo->addItem(QString("%1×%1").arg(box * box), box);
+    ui_->sizeCombo->setCurrentIndex(ui_->sizeCombo->findData(ui_->grid->boxSize()));
+    connect(ui_->sizeCombo, &QComboBox::currentIndexChanged, this, [this] {
+        onBoardSize(ui_->sizeCombo->currentData().toInt());
+    });
+
+    // Single hard puzzles are split across all cores; one core gains nothing from it
+    if (std::thread::hardware_concurrency() > 1)
+    {
+        solvePool_ = std::make_unique<ThreadPool>();
+        parallelSolver_ = std::make_unique<ParallelSolver>(*solvePool_);
+    }
+    solver_.setCancelToken(&cancelSolve_);
+
+    // Solutions of earlier sessions; a missing or outdated file just starts empty
+    cache_.load(cachePath().toStdString());
+    solver_.setCache(&cache_);
+
     // Connect button signals to slots
     connect(ui_->solveBtn, &QPushButton::clicked, this, &MainWindow::onSolve);
     connect(ui_->animateBtn, &QPushButton::clicked, this, &MainWindow::onAnimate);
     connect(ui_->newPuzzleBtn, &QPushButton::clicked, this, &MainWindow::onNewPuzzle);
     connect(ui_->clearBtn, &QPushButton::clicked, this, &MainWindow::onClear);
+    connect(ui_->openBtn, &QPushButton::clicked, this, &MainWindow::onOpenPuzzle);
+
+    // Playback controls (slider range grows as steps arrive)
+    connect(ui_->traceSlider, &QSlider::valueChanged, this, &MainWindow::onSeek);
+    connect(ui_->durationSpin, &QSpinBox::valueChanged, this, [this](const int seconds) {
+        ui_->speedSpin->setEnabled(seconds == 0);
+        playedMs_ = 0; // the new target applies to the rest of the trace
+    });
+    connect(ui_->stepBackBtn, &QToolButton::clicked, this, &MainWindow::onStepBackward);
+    connect(ui_->stepForwardBtn, &QToolButton::clicked, this, &MainWindow::onStepForward);
+
+    // Results of background solves (emitted from the worker thread, delivered queued)
+    qRegisterMetaType<SolveStats>();
+    connect(this, &MainWindow::solveFinished, this, &MainWindow::onSolveFinished, Qt::QueuedConnection);
+}
+
+// Destructor - the worker captures this, so it must be gone before the members are
+MainWindow::~MainWindow()
+{
+    if (solveThread_)
+    {
+        cancelSolve_.store(true, std::memory_order_relaxed);
+        solveThread_->wait();
+    }
+    QDir().mkpath(QFileInfo(cachePath()).path());
+    cache_.save(cachePath().toStdString());
 }
 
-// Destructor
-MainWindow::~MainWindow() = default;
+QString MainWindow::cachePath()
+{
+    return QStandardPaths::writableLocation(QStandardPaths::AppDataLocation) + "/solutions.cache";
+}
+
+// Engine currently selected in the combo box
+EngineKind MainWindow::selectedEngine() const
+{
+    return static_cast<EngineKind>(ui_->engineCombo->currentData().toInt());
+}
+
+// Background solving - one job at a time, results come back as queued signals
+void MainWindow::startSolveJob(const std::function<void()> &job)
+{
+    cancelSolve_.store(false, std::memory_order_relaxed);
+    solveThread_ = QThread::create(job);
+    connect(solveThread_, &QThread::finished, solveThread_, &QObject::deleteLater);
+    solveThread_->start();
+}
 
-// Fast Solve - Instantly solve current puzzle and display result
-void MainWindow::onSolve() const
+void MainWindow::cancelSolve()
+{
+    if (!solveThread_)
+        return;
+    cancelSolve_.store(true, std::memory_order_relaxed);
+    releaseSolveThread();
+    ++solveJob_; // the result of the stopped job may still be queued
+    ui_->solveBtn->setText("⚡ Solve");
+    ui_->animateBtn->setText("🎬  Animation");
+}
+
+void MainWindow::releaseSolveThread()
+{
+    if (solveThread_)
+        solveThread_->wait(); // deletes itself via deleteLater once finished
+    solveThread_ = nullptr;
+    streaming_ = false;
+}
+
+void MainWindow::stopAnimation()
 {
-    // Stop any running animation
     if (animTimer_->isActive())
     {
         animTimer_->stop();
         ui_->animateBtn->setText("🎬  Animation");
     }
+}
+
+// Fast Solve - Solve current puzzle on a worker thread and display result
+void MainWindow::onSolve()
+{
+    // Second click while solving acts as Stop
+    if (solveThread_ && !streaming_)
+    {
+        cancelSolve();
+        ui_->statusLabel->setText("⏹ Solve stopped");
+        return;
+    }
+    stopAnimation();
+    cancelSolve(); // drop the animation producer, if any
+    resetPlayback();
+
+    // Get current board (flat bytes of any size) and solve it
+    solveInput_ = gridBytes(*ui_->grid);
+    const int box = ui_->grid->boxSize();
+    const EngineKind engine = selectedEngine();
+    const quint64 job = ++solveJob_;
+    if (box != 3)
+    {
+        // Other sizes: the selected engine on the worker, no cache
+        startSolveJob([this, input = solveInput_, box, engine, job] {
+            QElapsedTimer et;
+            et.start();
+            QByteArray solution = input;
+            SolveStats stats;
+            bool solved = false;
+            withBoxSize(box, [&](auto size) {
+                constexpr int Box = decltype(size)::value;
+                auto board = fromBytes<Box>(input);
+                const auto sized = SolverRegistry::create<Box>(engine);
+                sized->setCancelToken(&cancelSolve_);
+                sized->setProfiling(true);
+                solved = sized->solve(board, nullptr);
+                stats = sized->stats();
+                solution = toBytes(board);
+            });
+            emit solveFinished(job, solved, false, cancelSolve_.load(std::memory_order_relaxed), solution,
+                               et.elapsed(), stats);
+        });
+        ui_->solveBtn->setText("⏹  Stop");
+        ui_->statusLabel->setText("⏳ Solving...");
+        ui_->statusLabel->setToolTip(QString());
+        return;
+    }
 
-    // Get current board and solve it (const reference to avoid copy)
-    const auto &board = ui_->grid->getCurrentBoard();
-    Sudoku sudoku(board);
+    const SudokuBoard board = fromBytes<3>(solveInput_);
+    ParallelSolver *parallel = parallelSolver_.get();
+    if (parallel)
+    {
+        parallel->setEngine(engine);
+        parallel->setCancelToken(&cancelSolve_);
+        parallel->setProfiling(true);
+    }
+
+    startSolveJob([this, board, engine, job, parallel] {
+        // Measure solving time
+        QElapsedTimer et;
+        et.start();
+        SudokuBoard solution = board;
+        SolveStats stats;
+        bool solved = false;
+        bool cached = false;
+
+        // One job at a time, so the worker may use solver_ until it finishes
+        solver_.reset(board);
+        if (parallel)
+        {
+            // solver_ only does the cache lookup; the search runs on all cores
+            cached = solved = solver_.solveFromCache();
+            if (cached)
+            {
+                solution = solver_.board();
+            }
+            else
+            {
+                solved = parallel->solve(solution);
+                stats = parallel->stats();
+                if (solved)
+                    solver_.cacheSolution(solution);
+            }
+        }
+        else
+        {
+            solver_.setEngine(engine);
+            solver_.setProfiling(true);
+            solved = solver_.solve();
+            cached = solver_.solvedFromCache();
+            solution = solver_.board();
+            stats = solver_.stats();
+        }
+        emit solveFinished(job, solved, cached, cancelSolve_.load(std::memory_order_relaxed), toBytes(solution),
+                           et.elapsed(), stats);
+    });
 
-    // Measure solving time
-    QElapsedTimer et;
-    et.start();
-    const bool solved = sudoku.solve();
-    const qint64 elapsed = et.elapsed();
+    ui_->solveBtn->setText("⏹  Stop");
+    ui_->statusLabel->setText("⏳ Solving...");
+    ui_->statusLabel->setToolTip(QString());
+}
+
+void MainWindow::onSolveFinished(const quint64 job, const bool solved, const bool cached, const bool cancelled,
+                                 const QByteArray &solution, const qint64 elapsedMs, const SolveStats &stats)
+{
+    if (job != solveJob_)
+        return;
+    releaseSolveThread();
+    ui_->solveBtn->setText("⚡ Solve");
 
-    if (solved)
+    if (cancelled)
+    {
+        ui_->statusLabel->setText("⏹ Solve stopped");
+    }
+    else if (solved)
     {
         // Apply solved cells to grid
-        for (size_t r = 0; r < 9; ++r)
-            for (size_t c = 0; c < 9; ++c)
-                if (board[r][c] == 0)
-                    ui_->grid->applyStep({static_cast<int>(r), static_cast<int>(c), sudoku.getCell(static_cast<int>(r), static_cast<int>(c))});
+        const int size = ui_->grid->size();
+        for (qsizetype i = 0; i < solveInput_.size(); ++i)
+            if (solveInput_[i] == 0)
+                ui_->grid->applyStep({static_cast<int>(i) / size, static_cast<int>(i) % size,
+                                      static_cast<std::uint8_t>(solution[i])});
 
         // Display timing
-        if (elapsed == 0)
+        if (elapsedMs == 0)
             ui_->timeLabel->setText("⏱  < 1 ms");
         else
-            ui_->timeLabel->setText(QString("⏱  %1 ms").arg(elapsed));
-        ui_->statusLabel->setText("✅ Solved!");
+            ui_->timeLabel->setText(QString("⏱  %1 ms").arg(elapsedMs));
+        if (cached)
+            ui_->statusLabel->setText(QString("✅ Solved from cache (%1 puzzles cached)").arg(cache_.size()));
+        else
+            ui_->statusLabel->setText(
+                QString("✅ Solved! %1 nodes, %2 backtracks").arg(stats.nodes).arg(stats.backtracks));
     }
     else
     {
         ui_->statusLabel->setText("❌ Unsolvable (check input)");
     }
+
+    // Full profile on hover (times are CPU time summed over workers)
+    const auto us = [](std::chrono::nanoseconds t) {
+        return QString::number(std::chrono::duration<double, std::micro>(t).count(), 'f', 0);
+    };
+    ui_->statusLabel->setToolTip(
+        cancelled || cached ? QString()
+                  : QString("Nodes: %1\nBacktracks: %2\nCandidate tests: %3\nDeductions: %4\nMax depth: %5\n"
+                            "Setup: %6 µs\nSearch: %7 µs\nPropagation: %8 µs")
+                        .arg(stats.nodes)
+                        .arg(stats.backtracks)
+                        .arg(stats.candidateTests)
+                        .arg(stats.deductions)
+                        .arg(stats.maxDepth)
+                        .arg(us(stats.setupTime), us(stats.searchTime), us(stats.propagationTime)));
 }
 
 // Animated Solve - Show step-by-step solving process
 void MainWindow::onAnimate()
 {
-    // If already animating, pause it
+    // If already animating, pause it (the producer waits on the full queue meanwhile)
     if (animTimer_->isActive())
     {
         animTimer_->stop();
@@ -127,76 +335,285 @@ void MainWindow::onAnimate()
         return;
     }
 
-    // Get current board and solve with step tracking (const reference)
-    const auto &board = ui_->grid->getCurrentBoard();
-    Sudoku sudoku(board);
-
-    const bool solvable = sudoku.solveWithSteps(solveSteps_);
-    if (!solvable)
+    // Resume a paused playback that still has steps to show
+    if (animLoaded_ && (playback_->position() < playback_->size() || !playback_->finished()))
     {
-        ui_->statusLabel->setText("❌ Unsolvable");
+        animTimer_->start();
+        ui_->animateBtn->setText("⏹  Stop");
         return;
     }
 
-    // Reset board and start animation
-    ui_->grid->loadBoard(board);
-    currentStep_ = 0;
+    // Start over: drop a running solve or a finished trace
+    cancelSolve();
+
+    // Stream steps from a worker; playback starts with the first frame, not after the whole solve
+    const EngineKind engine = selectedEngine();
+    ++solveJob_;
+    streaming_ = true;
+    playback_->start(*ui_->grid, &cancelSolve_);
+
+    startSolveJob([this, engine] { playback_->produce(solver_, engine); });
+
+    animLoaded_ = true;
+    playedMs_ = 0;
 
     animTimer_->start();
     ui_->animateBtn->setText("⏹  Stop");
-    ui_->statusLabel->setText(QString("🎬 Step: 1/%1").arg(solveSteps_.size()));
+    updatePlayback();
 }
 
-// Animation Step - Process next step in animation
+// Slider range/position and step counter; the slider must not echo back into onSeek
+void MainWindow::updatePlayback() const
+{
+    const QSignalBlocker blocker(ui_->traceSlider);
+    ui_->traceSlider->setMaximum(static_cast<int>(playback_->size()));
+    ui_->traceSlider->setValue(static_cast<int>(playback_->position()));
+    ui_->statusLabel->setText(QString("🎬 Step: %1/%2").arg(playback_->position()).arg(playback_->size()));
+}
+
+// Forget the trace (the grid no longer shows its puzzle); no solve job may be running
+void MainWindow::resetPlayback()
+{
+    animLoaded_ = false;
+    if (playback_->boxSize() != ui_->grid->boxSize())
+        playback_ = Playback::create(ui_->grid->boxSize());
+    else
+        playback_->clear();
+    const QSignalBlocker blocker(ui_->traceSlider);
+    ui_->traceSlider->setMaximum(0);
+}
+
+// Steps to show this frame: fixed speed, or spread the rest over the remaining target duration
+size_t MainWindow::stepsPerFrame()
+{
+    const int targetSeconds = ui_->durationSpin->value();
+    if (targetSeconds == 0)
+        return static_cast<size_t>(ui_->speedSpin->value());
+
+    const qint64 interval = animTimer_->interval();
+    const qint64 framesLeft = std::max<qint64>(1, (targetSeconds * qint64{1000} - playedMs_) / interval);
+    playedMs_ += interval;
+    const size_t remaining = playback_->size() - playback_->position();
+    return std::max<size_t>(1, (remaining + static_cast<size_t>(framesLeft) - 1) / static_cast<size_t>(framesLeft));
+}
+
+// Animation Step - Apply one frame worth of steps within the frame budget
 void MainWindow::onAnimStep()
 {
-    // Check if animation is complete
-    if (currentStep_ >= solveSteps_.size())
+    // finished() is read before draining, so steps pushed before finish() are not missed
+    const bool producerDone = playback_->finished();
+    playback_->drain();
+    playback_->advance(stepsPerFrame(), std::chrono::steady_clock::now() + FRAME_BUDGET, *ui_->grid);
+
+    if (producerDone && playback_->position() == playback_->size())
     {
+        // Animation complete; the producer has returned from finish() or is about to
         animTimer_->stop();
-        ui_->grid->markSolved();
+        releaseSolveThread();
+        updatePlayback();
         ui_->animateBtn->setText("🎬  Animation");
-        ui_->statusLabel->setText("✅ Completed!");
-        ui_->timeLabel->setText(QString("⏱  %1 steps").arg(solveSteps_.size()));
+        if (playback_->solved())
+        {
+            ui_->grid->markSolved();
+            ui_->statusLabel->setText("✅ Completed!");
+        }
+        else
+        {
+            ui_->statusLabel->setText("❌ Unsolvable");
+        }
+        ui_->timeLabel->setText(QString("⏱  %1 steps").arg(playback_->size()));
         return;
     }
+    updatePlayback();
+}
 
-    // Apply current step
-    ui_->grid->applyStep(solveSteps_[currentStep_++]);
-    ui_->statusLabel->setText(QString("🎬 Step: %1/%2").arg(currentStep_).arg(solveSteps_.size()));
+// Seek - jump to any received step (snapshot + at most one interval of replay)
+void MainWindow::onSeek(const int step)
+{
+    if (!animLoaded_)
+        return;
+    playback_->drain();
+    playback_->seek(static_cast<size_t>(std::max(step, 0)), *ui_->grid);
+    updatePlayback();
 }
 
-// New Puzzle - Load random example puzzle
-void MainWindow::onNewPuzzle() const
+void MainWindow::onStepBackward()
 {
-    // Stop any running animation
-    if (animTimer_->isActive())
+    if (!animLoaded_ || playback_->position() == 0)
+        return;
+    stopAnimation();
+    onSeek(static_cast<int>(playback_->position()) - 1);
+}
+
+void MainWindow::onStepForward()
+{
+    if (!animLoaded_)
+        return;
+    stopAnimation();
+    playback_->drain();
+    playback_->stepForward(*ui_->grid);
+    updatePlayback();
+}
+
+// Open Corpus - Map a binary puzzle collection (records are read lazily, so any size opens at once)
+bool MainWindow::openCorpus(const QString &path)
+{
+    std::string error;
+    if (!corpus_.open(path.toStdString(), &error))
     {
-        animTimer_->stop();
-        ui_->animateBtn->setText("🎬  Animation");
+        ui_->statusLabel->setText(QString("⚠ %1").arg(QString::fromStdString(error)));
+        return false;
+    }
+    ui_->statusLabel->setText(QString("📚 Corpus: %1 puzzles%2")
+                                  .arg(corpus_.size())
+                                  .arg(corpus_.rated() ? ", rated" : ""));
+    return true;
+}
+
+// New Puzzle - Draw from the corpus or generate a fresh unique puzzle (milliseconds even for rare buckets)
+void MainWindow::onNewPuzzle()
+{
+    // Stop any running solve or animation
+    cancelSolve();
+    stopAnimation();
+
+    const int level = ui_->difficultyCombo->currentData().toInt();
+    SudokuBoard puzzle;
+    Rating rating;
+    std::optional<std::size_t> record;
+    if (corpus_.isOpen() && corpus_.size() > 0)
+    {
+        const auto pick = [this](const std::size_t n) {
+            return std::uniform_int_distribution<std::size_t>(0, n - 1)(corpusRng_);
+        };
+        if (level < 0)
+            record = pick(corpus_.size());
+        else if (const auto bucket = static_cast<Difficulty>(level); corpus_.bucketSize(bucket) > 0)
+            record = corpus_.bucketAt(bucket, pick(corpus_.bucketSize(bucket)));
+        if (record && !corpus_.valid(*record))
+            record.reset(); // damaged record: fall back to the generator
     }
 
-    // Select and load random puzzle
-    static std::mt19937 rng{std::random_device{}()};
-    std::uniform_int_distribution<size_t> dist(0, PUZZLES.size() - 1);
-    ui_->grid->loadBoard(PUZZLES[dist(rng)]);
+    if (record)
+    {
+        puzzle = corpus_.at(*record);
+        rating = rater_.rate(puzzle);
+    }
+    else if (level < 0)
+    {
+        puzzle = generator_.generate(ui_->cluesSpin->value());
+        rating = rater_.rate(puzzle);
+    }
+    else
+    {
+        puzzle = generator_.generate(static_cast<Difficulty>(level), nullptr, &rating);
+    }
+    ui_->grid->loadBoard(puzzle);
+    resetPlayback();
 
+    const auto clues = std::ranges::count_if(puzzle.cells, [](const std::uint8_t v) { return v != 0; });
+    const auto text = [](const std::string_view name) {
+        return QString::fromUtf8(name.data(), static_cast<qsizetype>(name.size()));
+    };
+    const QString source = record ? QString("📚 Corpus #%1").arg(*record) : QString("🎲 New puzzle");
     ui_->timeLabel->setText("⏱  Time: —");
-    ui_->statusLabel->setText("🎲 New puzzle loaded");
+    ui_->statusLabel->setText(QString("%1: %2 clues, %3 (%4)")
+                                  .arg(source)
+                                  .arg(clues)
+                                  .arg(text(DifficultyRater::name(rating.difficulty)))
+                                  .arg(rating.score, 0, 'f', 1));
+    ui_->statusLabel->setToolTip(QString("Hardest technique: %1").arg(text(DifficultyRater::name(rating.hardest))));
 }
 
 // Clear - Remove all user inputs (keep given cells)
-void MainWindow::onClear() const
+void MainWindow::onClear()
 {
-    // Stop any running animation
-    if (animTimer_->isActive())
-    {
-        animTimer_->stop();
-        ui_->animateBtn->setText("🎬  Animation");
-    }
+    // Stop any running solve or animation
+    cancelSolve();
+    stopAnimation();
 
     // Clear user input
     ui_->grid->clearUserInput();
+    resetPlayback();
     ui_->timeLabel->setText("⏱  Time: —");
     ui_->statusLabel->setText("🗑 Inputs cleared");
+    ui_->statusLabel->setToolTip(QString());
+}
+
+// Board Size - Start an empty board of another size (type digits, or open a puzzle file)
+void MainWindow::onBoardSize(const int box)
+{
+    if (box == ui_->grid->boxSize())
+        return;
+    cancelSolve();
+    stopAnimation();
+
+    withBoxSize(box, [this](auto size) { ui_->grid->loadBoard(BasicBoard<decltype(size)::value>{}); });
+    resetPlayback();
+    updateSizeControls();
+    ui_->timeLabel->setText("⏱  Time: —");
+    ui_->statusLabel->setText(QString("%1×%1 board").arg(ui_->grid->size()));
+    ui_->statusLabel->setToolTip(QString());
+}
+
+void MainWindow::onOpenPuzzle()
+{
+    const QString path =
+        QFileDialog::getOpenFileName(this, "Open Puzzle", QString(), "Puzzles (*.txt *.sdk);;All files (*)");
+    if (!path.isEmpty())
+        openPuzzle(path);
+}
+
+// Open Puzzle - First puzzle line of a text file; its length gives the board size
+bool MainWindow::openPuzzle(const QString &path)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text))
+    {
+        ui_->statusLabel->setText(QString("⚠ Cannot open %1").arg(path));
+        return false;
+    }
+    QByteArray line;
+    while (!file.atEnd() && (line.isEmpty() || line.startsWith('#')))
+        line = file.readLine().trimmed();
+
+    const int box = boxSizeForCells(static_cast<std::size_t>(line.size()));
+    const bool loaded = box != 0 && withBoxSize(box, [&](auto size) {
+        BasicBoard<decltype(size)::value> board;
+        if (!decltype(board)::parse(std::string_view(line.constData(), static_cast<size_t>(line.size())), board))
+            return false;
+        cancelSolve();
+        stopAnimation();
+        ui_->grid->loadBoard(board);
+        return true;
+    });
+    if (!loaded)
+    {
+        ui_->statusLabel->setText(
+            QString("⚠ %1: no 4×4, 9×9, 16×16 or 25×25 puzzle line").arg(QFileInfo(path).fileName()));
+        return false;
+    }
+
+    resetPlayback();
+    updateSizeControls();
+    const auto clues = std::ranges::count_if(line, [](const char ch) { return ch != '.' && ch != '0'; });
+    ui_->timeLabel->setText("⏱  Time: —");
+    ui_->statusLabel->setText(QString("📂 %1: %2×%2, %3 clues")
+                                  .arg(QFileInfo(path).fileName())
+                                  .arg(ui_->grid->size())
+                                  .arg(clues));
+    ui_->statusLabel->setToolTip(QString());
+    return true;
+}
+
+// Generator, rater and corpus are 9x9-only; the size combo follows boards loaded from files
+void MainWindow::updateSizeControls()
+{
+    const bool classic = ui_->grid->boxSize() == 3;
+    ui_->newPuzzleBtn->setEnabled(classic);
+    ui_->difficultyCombo->setEnabled(classic);
+    ui_->cluesSpin->setEnabled(classic && ui_->difficultyCombo->currentData().toInt() < 0);
+
+    const QSignalBlocker blocker(ui_->sizeCombo);
+    ui_->sizeCombo->setCurrentIndex(ui_->sizeCombo->findData(ui_->grid->boxSize()));
 }
@@ -0,0 +1,171 @@
+#include "ParallelSolver.hpp"
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+
+namespace {
+    using Mask = std::uint16_t; ///< Digit set, bit (n - 1) represents digit n
+    constexpr Mask ALL_DIGITS = 0x1FF; ///< Digits 1-9 set
+
+    /**
+     * @brief Find the empty cell with the fewest candidates
+     * @param board Board to scan
+     * @param bestCand Receives the candidate set of the chosen cell (0 = dead end)
+     * @return Cell index, or -1 if the board is full
+     */
+    int mostConstrained(const SudokuBoard &board, Mask &bestCand) {
+        std::array<Mask, 9> rows{};
+        std::array<Mask, 9> cols{};
+        std::array<Mask, 9> boxes{};
+        for (int cell = 0; cell < SudokuBoard::CELLS; ++cell) {
+            const int val = board.cells[static_cast<size_t>(cell)];
+            if (val == 0) continue;
+            const auto bit = static_cast<Mask>(1U << (val - 1));
+            const int r = cell / 9;
+            const int c = cell % 9;
+            rows[static_cast<size_t>(r)] |= bit;
+            cols[static_cast<size_t>(c)] |= bit;
+            boxes[static_cast<size_t>((r / 3) * 3 + c / 3)] |= bit;
+        }
+
+        int best = -1;
+        int bestCount = 10;
+        for (int cell = 0; cell < SudokuBoard::CELLS && bestCount > 1; ++cell) {
+            if (board.cells[static_cast<size_t>(cell)] != 0) continue;
+            const int r = cell / 9;
+            const int c = cell % 9;
+            const auto used = rows[static_cast<size_t>(r)] | cols[static_cast<size_t>(c)]
+                              | boxes[static_cast<size_t>((r / 3) * 3 + c / 3)];
+            const auto cand = static_cast<Mask>(~used & ALL_DIGITS);
+            const int count = std::popcount(cand);
+            if (count < bestCount) {
+                best = cell;
+                bestCount = count;
+                bestCand = cand;
+            }
+        }
+        return best;
+    }
+}
+
+ParallelSolver::ParallelSolver(ThreadPool &pool, EngineKind engine)
+    : pool_(pool), engineKind_(engine) {
+}
+
+// Engines are rebuilt lazily on the next call
+void ParallelSolver::setEngine(EngineKind engine) {
+    if (engine == engineKind_) return;
+    engineKind_ = engine;
+    engines_.clear();
+}
+
+// Breadth-first expansion of the top levels; dead ends are dropped on the way
+void ParallelSolver::split(const SudokuBoard &board) {
+    const std::size_t target = pool_.size() * SPLIT_FACTOR;
+    subtrees_.assign(1, board);
+    for (int depth = 0; depth < MAX_SPLIT_DEPTH && !subtrees_.empty() && subtrees_.size() < target; ++depth) {
+        frontier_.swap(subtrees_);
+        subtrees_.clear();
+        for (const auto &node: frontier_) {
+            Mask cand = 0;
+            const int cell = mostConstrained(node, cand);
+            if (cell < 0) {
+                subtrees_.push_back(node); // already complete, let an engine validate it
+                continue;
+            }
+            for (; cand != 0; cand &= static_cast<Mask>(cand - 1)) {
+                SudokuBoard &child = subtrees_.emplace_back(node);
+                child.cells[static_cast<size_t>(cell)] = static_cast<std::uint8_t>(std::countr_zero(cand) + 1);
+            }
+        }
+    }
+}
+
+template<typename Body>
+void ParallelSolver::runSubtrees(Body &body) {
+    if (engines_.size() != pool_.size()) {
+        engines_.clear();
+        for (std::size_t i = 0; i < pool_.size(); ++i)
+            engines_.push_back(SolverRegistry::create(engineKind_));
+    }
+    for (auto &engine: engines_) {
+        engine->setCancelToken(&stop_);
+        engine->setProfiling(profile_);
+    }
+    stop_.store(cancel_ != nullptr && cancel_->load(std::memory_order_relaxed), std::memory_order_relaxed);
+
+    // State of this call, shared with the worker tasks through one pointer
+    struct Batch {
+        ParallelSolver &solver; ///< Owner of engines_, subtrees_ and stop_
+        Body &body; ///< Work per subtree
+        std::atomic<std::size_t> next{0}; ///< Next unclaimed subtree
+        std::mutex mutex{};
+        std::condition_variable finished{};
+        std::size_t running{0}; ///< Tasks not done yet (guarded by mutex)
+        SolveStats total{}; ///< Guarded by mutex
+    } batch{*this, body};
+    const std::size_t tasks = std::min(pool_.size(), subtrees_.size());
+    batch.running = tasks; // before the first submit: finishing tasks count it down
+
+    for (std::size_t t = 0; t < tasks; ++t) {
+        pool_.submit([state = &batch] {
+            ParallelSolver &self = state->solver;
+            SolverEngine &engine = *self.engines_[static_cast<std::size_t>(ThreadPool::currentWorker())];
+            SolveStats local;
+            for (std::size_t i = state->next.fetch_add(1, std::memory_order_relaxed);
+                 i < self.subtrees_.size() && !self.stop_.load(std::memory_order_relaxed);
+                 i = state->next.fetch_add(1, std::memory_order_relaxed)) {
+                state->body(engine, self.subtrees_[i]);
+                local.merge(engine.stats());
+            }
+            std::lock_guard lock(state->mutex);
+            state->total.merge(local);
+            if (--state->running == 0) state->finished.notify_one();
+        });
+    }
+
+    // Wait for the stragglers, polling the external flag in between
+    std::unique_lock lock(batch.mutex);
+    while (!batch.finished.wait_for(lock, std::chrono::milliseconds(2), [&] { return batch.running == 0; }))
+        if (cancel_ != nullptr && cancel_->load(std::memory_order_relaxed)) stop_.store(true, std::memory_order_relaxed);
+
+    stats_ = batch.total;
+}
+
+bool ParallelSolver::solve(SudokuBoard &board) {
+    const auto start = std::chrono::steady_clock::now();
+    split(board);
+    const auto splitTime = std::chrono::steady_clock::now() - start;
+    std::mutex resultMutex;
+    bool found = false;
+    auto body = [&](SolverEngine &engine, SudokuBoard &subtree) {
+        if (!engine.solve(subtree, nullptr)) return;
+        std::lock_guard lock(resultMutex);
+        if (!found) {
+            found = true;
+            board = subtree;
+        }
+        stop_.store(true, std::memory_order_relaxed); // first solution wins, cancel siblings
+    };
+    runSubtrees(body);
+    if (profile_) stats_.setupTime += std::chrono::duration_cast<std::chrono::nanoseconds>(splitTime);
+    return found;
+}
+
+std::uint64_t ParallelSolver::countSolutions(const SudokuBoard &board, std::uint64_t limit) {
+    stats_ = {};
+    if (limit == 0) return 0;
+
+    split(board);
+    std::atomic<std::uint64_t> total{0};
+    auto body = [&](SolverEngine &engine, SudokuBoard &subtree) {
+        const std::uint64_t found = engine.countSolutions(subtree, limit);
+        if (total.fetch_add(found, std::memory_order_relaxed) + found >= limit)
+            stop_.store(true, std::memory_order_relaxed); // enough solutions overall
+    };
+    runSubtrees(body);
+    return std::min(total.load(std::memory_order_relaxed), limit);
+}
@@ -0,0 +1,91 @@
+#include "Playback.hpp"
+#include "StepStream.hpp"
+#include "Sudoku.hpp"
+#include "SudokuGrid.hpp"
+#include "TracePlayer.hpp"
+
+namespace {
+    /**
+     * @class BasicPlayback
+     * @brief Playback of one board size
+     * @tparam Box Box side (see BasicBoard)
+     */
+    template<int Box>
+    class BasicPlayback final : public Playback {
+        using Board = BasicBoard<Box>; ///< Board type played
+
+        BasicStepStream<Box> stream_; ///< Bounded queue from the solver thread
+        BasicTracePlayer<Box> player_; ///< Steps received so far, seekable
+        Board start_; ///< Puzzle of the current trace
+        const std::atomic<bool> *cancel_{nullptr}; ///< Cancellation token of the producer
+
+    public:
+        [[nodiscard]] int boxSize() const override { return Box; }
+
+        void start(SudokuGrid &grid, const std::atomic<bool> *cancel) override {
+            start_ = grid.currentBoard<Box>();
+            cancel_ = cancel;
+            stream_.reset(cancel);
+            player_.reset(start_);
+            grid.loadBoard(start_);
+        }
+
+        void produce(Sudoku &solver, const EngineKind engine) override {
+            if constexpr (Box == 3) {
+                solver.reset(start_);
+                solver.setEngine(engine);
+                solver.setProfiling(false);
+                stream_.finish(solver.solveWithSteps(stream_));
+            } else {
+                const auto sized = SolverRegistry::create<Box>(engine);
+                sized->setCancelToken(cancel_);
+                Board board = start_;
+                stream_.finish(sized->solve(board, &stream_));
+            }
+        }
+
+        void clear() override { player_.reset(Board{}); }
+
+        void drain() override {
+            SolveStep step{};
+            while (stream_.tryPop(step)) player_.append(step);
+        }
+
+        [[nodiscard]] bool finished() const override { return stream_.finished(); }
+
+        [[nodiscard]] bool solved() const override { return stream_.solved(); }
+
+        [[nodiscard]] std::size_t size() const override { return player_.size(); }
+
+        [[nodiscard]] std::size_t position() const override { return player_.position(); }
+
+        // Steps only touch the trace board; each written cell is redrawn once per batch
+        void advance(const std::size_t count, const std::chrono::steady_clock::time_point deadline,
+                     SudokuGrid &grid) override {
+            typename BasicTracePlayer<Box>::Cells touched;
+            player_.advance(count, touched, deadline);
+            const auto &frame = player_.frame();
+            for (int cell = 0; cell < Board::CELLS; ++cell) {
+                if (!touched[static_cast<size_t>(cell)]) continue;
+                const bool deduced = frame.deduced[static_cast<size_t>(cell)];
+                grid.applyStep({cell / Board::SIZE, cell % Board::SIZE, frame.board.cells[static_cast<size_t>(cell)],
+                                deduced ? StepKind::Deduced : StepKind::Guess});
+            }
+        }
+
+        void seek(const std::size_t target, SudokuGrid &grid) override {
+            player_.seek(target);
+            grid.showBoard(player_.frame().board, player_.frame().deduced);
+        }
+
+        void stepForward(SudokuGrid &grid) override {
+            if (player_.position() < player_.size()) grid.applyStep(player_.stepForward());
+        }
+    };
+}
+
+std::unique_ptr<Playback> Playback::create(const int box) {
+    return withBoxSize(box, [](auto size) -> std::unique_ptr<Playback> {
+        return std::make_unique<BasicPlayback<decltype(size)::value> >();
+    });
+}
@@ -0,0 +1,275 @@
+#include "PuzzleCorpus.hpp"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <utility>
+
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+    // Header field offsets
+    constexpr std::size_t VERSION_AT = 8;
+    constexpr std::size_t RECORD_SIZE_AT = 12;
+    constexpr std::size_t COUNT_AT = 16;
+    constexpr std::size_t FLAGS_AT = 24;
+    constexpr std::size_t BUCKETS_AT = 32;
+    constexpr std::size_t INDEX_AT = BUCKETS_AT + 8 * DIFFICULTY_COUNT;
+    static_assert(INDEX_AT + 8 <= PuzzleCorpus::HEADER_SIZE);
+
+    template<typename T>
+    T load(const std::uint8_t *bytes) {
+        T value = 0;
+        for (std::size_t i = 0; i < sizeof(T); ++i) value |= static_cast<T>(static_cast<T>(bytes[i]) << (8 * i));
+        return value;
+    }
+
+    template<typename T>
+    void store(std::uint8_t *bytes, const T value) {
+        for (std::size_t i = 0; i < sizeof(T); ++i) bytes[i] = static_cast<std::uint8_t>(value >> (8 * i));
+    }
+
+    bool fail(std::string *error, const std::string &message) {
+        if (error != nullptr) *error = message;
+        return false;
+    }
+}
+
+// ──────────────────────────── PuzzleCorpus ────────────────────────────
+
+PuzzleCorpus::~PuzzleCorpus() {
+    close();
+}
+
+PuzzleCorpus::PuzzleCorpus(PuzzleCorpus &&other) noexcept {
+    *this = std::move(other);
+}
+
+PuzzleCorpus &PuzzleCorpus::operator=(PuzzleCorpus &&other) noexcept {
+    if (this != &other) {
+        close();
+        data_ = std::exchange(other.data_, nullptr);
+        length_ = std::exchange(other.length_, 0);
+        header_ = std::exchange(other.header_, {});
+        bucketStart_ = other.bucketStart_;
+#ifdef _WIN32
+        mapping_ = std::exchange(other.mapping_, nullptr);
+#endif
+    }
+    return *this;
+}
+
+void PuzzleCorpus::close() {
+    if (data_ != nullptr) {
+#ifdef _WIN32
+        UnmapViewOfFile(data_);
+        CloseHandle(mapping_);
+        mapping_ = nullptr;
+#else
+        munmap(const_cast<std::uint8_t *>(data_), length_);
+#endif
+    }
+    data_ = nullptr;
+    length_ = 0;
+    header_ = {};
+    bucketStart_ = {};
+}
+
+bool PuzzleCorpus::open(const std::string &path, std::string *error) {
+    close();
+
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                              FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) return fail(error, "cannot open " + path);
+    LARGE_INTEGER size{};
+    if (!GetFileSizeEx(file, &size) || static_cast<std::size_t>(size.QuadPart) < HEADER_SIZE) {
+        CloseHandle(file);
+        return fail(error, path + " is too short for a corpus header");
+    }
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    CloseHandle(file);
+    if (mapping == nullptr) return fail(error, "cannot map " + path);
+    const void *view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (view == nullptr) {
+        CloseHandle(mapping);
+        return fail(error, "cannot map " + path);
+    }
+    mapping_ = mapping;
+    length_ = static_cast<std::size_t>(size.QuadPart);
+#else
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) return fail(error, "cannot open " + path);
+    struct stat info{};
+    if (fstat(fd, &info) != 0 || static_cast<std::size_t>(info.st_size) < HEADER_SIZE) {
+        ::close(fd);
+        return fail(error, path + " is too short for a corpus header");
+    }
+    length_ = static_cast<std::size_t>(info.st_size);
+    void *view = mmap(nullptr, length_, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd); // the mapping keeps the file alive
+    if (view == MAP_FAILED) {
+        length_ = 0;
+        return fail(error, "cannot map " + path);
+    }
+    madvise(view, length_, MADV_RANDOM); // New Puzzle touches single records
+#endif
+    data_ = static_cast<const std::uint8_t *>(view);
+
+    // Validate before trusting any offset
+    const auto reject = [&](const std::string &message) {
+        close();
+        return fail(error, path + ": " + message);
+    };
+    if (std::memcmp(data_, MAGIC.data(), MAGIC.size()) != 0) return reject("not a puzzle corpus");
+    header_.version = load<std::uint32_t>(data_ + VERSION_AT);
+    if (header_.version != VERSION) return reject("unsupported corpus version " + std::to_string(header_.version));
+    if (load<std::uint32_t>(data_ + RECORD_SIZE_AT) != RECORD_SIZE) return reject("unexpected record size");
+    header_.count = load<std::uint64_t>(data_ + COUNT_AT);
+    header_.flags = load<std::uint32_t>(data_ + FLAGS_AT);
+    for (std::size_t b = 0; b < DIFFICULTY_COUNT; ++b)
+        header_.buckets[b] = load<std::uint64_t>(data_ + BUCKETS_AT + 8 * b);
+    header_.indexOffset = load<std::uint64_t>(data_ + INDEX_AT);
+
+    const std::uint64_t available = (length_ - HEADER_SIZE) / RECORD_SIZE;
+    if (header_.count > available) return reject("truncated (header promises more records than the file holds)");
+    if (rated()) {
+        std::uint64_t total = 0;
+        for (std::size_t b = 0; b < DIFFICULTY_COUNT; ++b) {
+            bucketStart_[b] = total;
+            total += header_.buckets[b];
+        }
+        const std::uint64_t recordsEnd = HEADER_SIZE + header_.count * RECORD_SIZE;
+        if (total != header_.count || header_.indexOffset < recordsEnd ||
+            header_.indexOffset > length_ || (length_ - header_.indexOffset) / 4 < total)
+            return reject("inconsistent bucket index");
+    }
+    return true;
+}
+
+std::optional<Difficulty> PuzzleCorpus::difficulty(const std::size_t index) const {
+    const auto nibble = static_cast<std::uint8_t>(record(index)[RECORD_SIZE - 1] >> 4);
+    if (nibble >= DIFFICULTY_COUNT) return std::nullopt;
+    return static_cast<Difficulty>(nibble);
+}
+
+std::size_t PuzzleCorpus::bucketSize(const Difficulty difficulty) const {
+    return rated() ? static_cast<std::size_t>(header_.buckets[static_cast<std::size_t>(difficulty)]) : 0;
+}
+
+std::optional<std::size_t> PuzzleCorpus::bucketAt(const Difficulty difficulty, const std::size_t n) const {
+    if (n >= bucketSize(difficulty)) return std::nullopt;
+    const std::uint64_t entry = bucketStart_[static_cast<std::size_t>(difficulty)] + n;
+    // open() only checked the index size; each entry must still name a record
+    const auto index = load<std::uint32_t>(data_ + header_.indexOffset + 4 * entry);
+    if (index >= header_.count) return std::nullopt;
+    return static_cast<std::size_t>(index);
+}
+
+PuzzleCorpus::Record PuzzleCorpus::pack(const SudokuBoard &board, const std::uint8_t difficulty) {
+    Record record{};
+    for (std::size_t i = 0; i < RECORD_SIZE - 1; ++i)
+        record[i] = static_cast<std::uint8_t>(board.cells[2 * i] | board.cells[2 * i + 1] << 4);
+    record[RECORD_SIZE - 1] = static_cast<std::uint8_t>(board.cells[SudokuBoard::CELLS - 1] | difficulty << 4);
+    return record;
+}
+
+SudokuBoard PuzzleCorpus::unpack(const std::span<const std::uint8_t, RECORD_SIZE> record) {
+    SudokuBoard board;
+    for (std::size_t i = 0; i < RECORD_SIZE - 1; ++i) {
+        board.cells[2 * i] = record[i] & 0xF;
+        board.cells[2 * i + 1] = static_cast<std::uint8_t>(record[i] >> 4);
+    }
+    board.cells[SudokuBoard::CELLS - 1] = record[RECORD_SIZE - 1] & 0xF;
+    return board;
+}
+
+bool PuzzleCorpus::isValid(const std::span<const std::uint8_t, RECORD_SIZE> record) {
+    constexpr auto SIZE = static_cast<std::uint8_t>(SudokuBoard::SIZE);
+    for (std::size_t i = 0; i < RECORD_SIZE - 1; ++i)
+        if ((record[i] & 0xF) > SIZE || record[i] >> 4 > SIZE) return false;
+    return (record[RECORD_SIZE - 1] & 0xF) <= SIZE;
+}
+
+bool PuzzleCorpus::isCorpus(const std::string &path) {
+    std::ifstream file(path, std::ios::binary);
+    std::array<char, MAGIC.size()> magic{};
+    return file.read(magic.data(), static_cast<std::streamsize>(magic.size())) && magic == MAGIC;
+}
+
+// ──────────────────────────── CorpusWriter ────────────────────────────
+
+CorpusWriter::~CorpusWriter() {
+    if (file_ != nullptr) std::fclose(file_);
+}
+
+bool CorpusWriter::open(const std::string &path) {
+    if (file_ != nullptr) std::fclose(file_);
+    file_ = std::fopen(path.c_str(), "wb");
+    count_ = 0;
+    for (auto &bucket: buckets_) bucket.clear();
+    rated_ = true;
+    failed_ = file_ == nullptr;
+    if (file_ == nullptr) return false;
+    const std::array<std::uint8_t, PuzzleCorpus::HEADER_SIZE> placeholder{};
+    failed_ = std::fwrite(placeholder.data(), 1, placeholder.size(), file_) != placeholder.size();
+    return !failed_;
+}
+
+void CorpusWriter::add(const SudokuBoard &board, const std::optional<Difficulty> difficulty) {
+    if (file_ == nullptr) return;
+    if (count_ == std::numeric_limits<std::uint32_t>::max()) {
+        failed_ = true; // bucket index entries are 32-bit
+        return;
+    }
+    if (difficulty)
+        buckets_[static_cast<std::size_t>(*difficulty)].push_back(static_cast<std::uint32_t>(count_));
+    else
+        rated_ = false;
+    const auto record = PuzzleCorpus::pack(
+        board, difficulty ? static_cast<std::uint8_t>(*difficulty) : PuzzleCorpus::UNRATED);
+    failed_ |= std::fwrite(record.data(), 1, record.size(), file_) != record.size();
+    ++count_;
+}
+
+bool CorpusWriter::finish(const bool unique) {
+    if (file_ == nullptr) return false;
+    const bool rated = rated_ && count_ > 0;
+
+    std::array<std::uint8_t, PuzzleCorpus::HEADER_SIZE> header{};
+    std::memcpy(header.data(), PuzzleCorpus::MAGIC.data(), PuzzleCorpus::MAGIC.size());
+    store(header.data() + VERSION_AT, PuzzleCorpus::VERSION);
+    store(header.data() + RECORD_SIZE_AT, static_cast<std::uint32_t>(PuzzleCorpus::RECORD_SIZE));
+    store(header.data() + COUNT_AT, count_);
+    store(header.data() + FLAGS_AT, (unique ? PuzzleCorpus::FLAG_UNIQUE : 0U) | (rated ? PuzzleCorpus::FLAG_RATED : 0U));
+    if (rated) {
+        for (std::size_t b = 0; b < DIFFICULTY_COUNT; ++b)
+            store(header.data() + BUCKETS_AT + 8 * b, static_cast<std::uint64_t>(buckets_[b].size()));
+        store(header.data() + INDEX_AT, PuzzleCorpus::HEADER_SIZE + count_ * PuzzleCorpus::RECORD_SIZE);
+        std::array<std::uint8_t, 4> entry{};
+        for (const auto &bucket: buckets_) {
+            for (const std::uint32_t index: bucket) {
+                store(entry.data(), index);
+                failed_ |= std::fwrite(entry.data(), 1, entry.size(), file_) != entry.size();
+            }
+        }
+    }
+
+    failed_ |= std::fseek(file_, 0, SEEK_SET) != 0;
+    failed_ |= std::fwrite(header.data(), 1, header.size(), file_) != header.size();
+    failed_ |= std::fclose(file_) != 0;
+    file_ = nullptr;
+    for (auto &bucket: buckets_) {
+        bucket.clear();
+        bucket.shrink_to_fit();
+    }
+    return !failed_;
+}
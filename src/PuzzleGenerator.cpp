@@ -0,0 +1,133 @@
+#include "PuzzleGenerator.hpp"
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <latch>
+#include <numeric>
+
+namespace {
+    using Mask = std::uint16_t; ///< Digit set, bit (n - 1) represents digit n
+    constexpr Mask ALL_DIGITS = 0x1FF; ///< Digits 1-9 set
+
+    /// Digits that may go into cell without clashing with its row, column or box
+    Mask candidates(const SudokuBoard &board, int cell) {
+        const int row = cell / 9;
+        const int col = cell % 9;
+        const int boxRow = row / 3 * 3;
+        const int boxCol = col / 3 * 3;
+        unsigned used = 0; // bit n = digit n present (bit 0 collects empty cells)
+        for (int i = 0; i < 9; ++i) {
+            used |= 1U << board.get(row, i);
+            used |= 1U << board.get(i, col);
+            used |= 1U << board.get(boxRow + i / 3, boxCol + i % 3);
+        }
+        return static_cast<Mask>(~(used >> 1) & ALL_DIGITS);
+    }
+
+    /// Fill count puzzles in blocks of BLOCK, one generator per block seeded from (seed, block)
+    template<typename Make>
+    std::vector<SudokuBoard> generateBlocks(ThreadPool &pool, const std::size_t count, const std::uint64_t seed,
+                                            const Make &make) {
+        constexpr std::size_t BLOCK = PuzzleGenerator::BLOCK;
+        std::vector<SudokuBoard> puzzles(count);
+        const std::size_t blocks = (count + BLOCK - 1) / BLOCK;
+        std::latch done(static_cast<std::ptrdiff_t>(blocks));
+        for (std::size_t block = 0; block < blocks; ++block) {
+            pool.submit([&, block] {
+                PuzzleGenerator generator(PuzzleGenerator::streamSeed(seed, block));
+                const std::size_t end = std::min(count, (block + 1) * BLOCK);
+                for (std::size_t i = block * BLOCK; i < end; ++i)
+                    puzzles[i] = make(generator);
+                done.count_down();
+            });
+        }
+        done.wait();
+        return puzzles;
+    }
+}
+
+PuzzleGenerator::PuzzleGenerator(std::uint64_t seed)
+    : rng_(seed), engine_(SolverRegistry::create(EngineKind::Propagation)) {
+}
+
+std::uint64_t PuzzleGenerator::streamSeed(std::uint64_t seed, std::uint64_t stream) {
+    std::uint64_t z = seed + (stream + 1) * 0x9E3779B97F4A7C15ULL;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+// Independent diagonal boxes first, the engine fills in the rest
+SudokuBoard PuzzleGenerator::solvedGrid() {
+    std::array<int, 9> digits{};
+    std::iota(digits.begin(), digits.end(), 1);
+    for (;;) {
+        SudokuBoard grid;
+        for (int box = 0; box < 3; ++box) {
+            std::shuffle(digits.begin(), digits.end(), rng_);
+            for (int i = 0; i < 9; ++i)
+                grid.set(box * 3 + i / 3, box * 3 + i % 3, digits[static_cast<size_t>(i)]);
+        }
+        if (engine_->solve(grid, nullptr)) return grid; // always, in practice
+    }
+}
+
+// The solution is fixed, so the puzzle stays unique iff no other candidate completes it
+bool PuzzleGenerator::tryRemove(SudokuBoard &puzzle, const int cell) {
+    const auto index = static_cast<size_t>(cell);
+    const std::uint8_t value = puzzle.cells[index];
+    puzzle.cells[index] = 0;
+
+    const auto own = static_cast<Mask>(1U << (value - 1));
+    for (Mask rest = candidates(puzzle, cell) & static_cast<Mask>(~own); rest != 0;
+         rest &= static_cast<Mask>(rest - 1)) {
+        trial_ = puzzle;
+        trial_.cells[index] = static_cast<std::uint8_t>(std::countr_zero(rest) + 1);
+        if (engine_->solve(trial_, nullptr)) {
+            puzzle.cells[index] = value; // second solution: the clue is needed
+            return false;
+        }
+    }
+    return true;
+}
+
+SudokuBoard PuzzleGenerator::generate(int clues, SudokuBoard *solution) {
+    clues = std::clamp(clues, MIN_CLUES, SudokuBoard::CELLS);
+    SudokuBoard puzzle = solvedGrid();
+    if (solution != nullptr) *solution = puzzle;
+
+    std::array<int, SudokuBoard::CELLS> order{};
+    std::iota(order.begin(), order.end(), 0);
+    std::shuffle(order.begin(), order.end(), rng_);
+
+    int remaining = SudokuBoard::CELLS;
+    for (const int cell: order) {
+        if (remaining <= clues) break;
+        if (tryRemove(puzzle, cell)) --remaining;
+    }
+    return puzzle;
+}
+
+SudokuBoard PuzzleGenerator::generate(const Difficulty difficulty, SudokuBoard *solution, Rating *rating) {
+    const int clues = difficulty == Difficulty::Easy ? EASY_CLUES : MIN_CLUES;
+    SudokuBoard puzzle;
+    Rating grade;
+    for (int attempt = 0; attempt < MAX_ATTEMPTS; ++attempt) {
+        puzzle = generate(clues, solution);
+        grade = rater_.rate(puzzle);
+        if (grade.difficulty == difficulty) break;
+    }
+    if (rating != nullptr) *rating = grade;
+    return puzzle;
+}
+
+std::vector<SudokuBoard> PuzzleGenerator::generateMany(ThreadPool &pool, const std::size_t count, const int clues,
+                                                       const std::uint64_t seed) {
+    return generateBlocks(pool, count, seed, [clues](PuzzleGenerator &generator) { return generator.generate(clues); });
+}
+
+std::vector<SudokuBoard> PuzzleGenerator::generateMany(ThreadPool &pool, const std::size_t count,
+                                                       const Difficulty difficulty, const std::uint64_t seed) {
+    return generateBlocks(pool, count, seed,
+                          [difficulty](PuzzleGenerator &generator) { return generator.generate(difficulty); });
+}
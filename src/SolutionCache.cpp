@@ -0,0 +1,211 @@
+#include "SolutionCache.hpp"
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstring>
+#include <fstream>
+
+namespace {
+    constexpr std::array<char, 8> MAGIC = {'S', 'D', 'K', 'C', 'A', 'C', 'H', 'E'}; ///< Cache file signature
+    constexpr std::size_t HEADER_SIZE = 24; ///< Magic, version, record size, count
+
+    /// FNV-1a over a packed board
+    std::uint64_t hashOf(const PuzzleCorpus::Record &key) {
+        std::uint64_t hash = 0xCBF29CE484222325ULL;
+        for (const std::uint8_t byte: key) hash = (hash ^ byte) * 0x100000001B3ULL;
+        return hash;
+    }
+
+    template<typename T>
+    T loadLE(const char *bytes) {
+        T value = 0;
+        for (std::size_t i = 0; i < sizeof(T); ++i)
+            value |= static_cast<T>(static_cast<T>(static_cast<unsigned char>(bytes[i])) << (8 * i));
+        return value;
+    }
+
+    /// Every cell of the key is empty or agrees with the solution, which is a complete valid grid
+    bool consistent(const SudokuBoard &key, const SudokuBoard &solution) {
+        std::array<std::uint16_t, 27> units{};
+        for (int row = 0; row < SudokuBoard::SIZE; ++row) {
+            for (int col = 0; col < SudokuBoard::SIZE; ++col) {
+                const int given = key.get(row, col);
+                const int value = solution.get(row, col);
+                if (value < 1 || value > SudokuBoard::SIZE || (given != 0 && given != value)) return false;
+                const auto bit = static_cast<std::uint16_t>(1U << value);
+                units[static_cast<std::size_t>(row)] |= bit;
+                units[static_cast<std::size_t>(9 + col)] |= bit;
+                units[static_cast<std::size_t>(18 + SudokuBoard::boxOf(row, col))] |= bit;
+            }
+        }
+        return std::ranges::all_of(units, [](const std::uint16_t unit) { return unit == 0x3FE; });
+    }
+
+    template<typename T>
+    void storeLE(char *bytes, const T value) {
+        for (std::size_t i = 0; i < sizeof(T); ++i) bytes[i] = static_cast<char>(value >> (8 * i));
+    }
+}
+
+SolutionCache::SolutionCache(const std::size_t capacity)
+    : entries_(std::max<std::size_t>(capacity, 1)),
+      index_(std::bit_ceil(std::max<std::size_t>(capacity, 1) * 2), NONE) {
+}
+
+// Index position holding key, or the empty position where it would go
+std::size_t SolutionCache::locate(const Record &key, const std::uint64_t hash) const {
+    const std::size_t mask = index_.size() - 1;
+    for (std::size_t position = hash & mask;; position = (position + 1) & mask) {
+        const std::uint32_t slot = index_[position];
+        if (slot == NONE) return position;
+        const Entry &entry = entries_[slot];
+        if (entry.hash == hash && entry.key == key) return position;
+    }
+}
+
+void SolutionCache::unlink(const std::uint32_t slot) {
+    Entry &entry = entries_[slot];
+    (entry.prev != NONE ? entries_[entry.prev].next : newest_) = entry.next;
+    (entry.next != NONE ? entries_[entry.next].prev : oldest_) = entry.prev;
+    entry.prev = entry.next = NONE;
+}
+
+void SolutionCache::pushFront(const std::uint32_t slot) {
+    Entry &entry = entries_[slot];
+    entry.prev = NONE;
+    entry.next = newest_;
+    if (newest_ != NONE) entries_[newest_].prev = slot;
+    newest_ = slot;
+    if (oldest_ == NONE) oldest_ = slot;
+}
+
+// Backward-shift deletion: later entries of the probe run move into the hole
+// unless their home position lies cyclically in (hole, position]
+void SolutionCache::eraseIndex(std::size_t hole) {
+    const std::size_t mask = index_.size() - 1;
+    index_[hole] = NONE;
+    for (std::size_t position = (hole + 1) & mask; index_[position] != NONE; position = (position + 1) & mask) {
+        const std::size_t home = entries_[index_[position]].hash & mask;
+        if (((position - home) & mask) >= ((position - hole) & mask)) {
+            index_[hole] = index_[position];
+            index_[position] = NONE;
+            hole = position;
+        }
+    }
+}
+
+void SolutionCache::insertLocked(const Record &key, const Record &solution) {
+    const std::uint64_t hash = hashOf(key);
+    std::size_t position = locate(key, hash);
+    std::uint32_t slot = index_[position];
+    if (slot != NONE) {
+        entries_[slot].solution = solution;
+        unlink(slot);
+        pushFront(slot);
+        return;
+    }
+
+    if (size_ < entries_.size()) {
+        slot = static_cast<std::uint32_t>(size_++);
+    } else {
+        slot = oldest_;
+        unlink(slot);
+        eraseIndex(locate(entries_[slot].key, entries_[slot].hash));
+        position = locate(key, hash); // the shift may have moved the free position
+    }
+    Entry &entry = entries_[slot];
+    entry.key = key;
+    entry.solution = solution;
+    entry.hash = hash;
+    index_[position] = slot;
+    pushFront(slot);
+}
+
+std::optional<SudokuBoard> SolutionCache::find(const SudokuBoard &canonical) {
+    const Record key = PuzzleCorpus::pack(canonical);
+    const std::lock_guard lock(mutex_);
+    const std::uint32_t slot = index_[locate(key, hashOf(key))];
+    if (slot == NONE) {
+        ++misses_;
+        return std::nullopt;
+    }
+    ++hits_;
+    unlink(slot);
+    pushFront(slot);
+    return PuzzleCorpus::unpack(entries_[slot].solution);
+}
+
+void SolutionCache::insert(const SudokuBoard &canonical, const SudokuBoard &solution) {
+    const Record key = PuzzleCorpus::pack(canonical);
+    const Record packed = PuzzleCorpus::pack(solution);
+    const std::lock_guard lock(mutex_);
+    insertLocked(key, packed);
+}
+
+void SolutionCache::clear() {
+    const std::lock_guard lock(mutex_);
+    std::ranges::fill(index_, NONE);
+    size_ = 0;
+    newest_ = oldest_ = NONE;
+}
+
+std::size_t SolutionCache::size() const {
+    const std::lock_guard lock(mutex_);
+    return size_;
+}
+
+std::uint64_t SolutionCache::hits() const {
+    const std::lock_guard lock(mutex_);
+    return hits_;
+}
+
+std::uint64_t SolutionCache::misses() const {
+    const std::lock_guard lock(mutex_);
+    return misses_;
+}
+
+bool SolutionCache::save(const std::string &path) const {
+    const std::lock_guard lock(mutex_);
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file) return false;
+
+    std::array<char, HEADER_SIZE> header{};
+    std::memcpy(header.data(), MAGIC.data(), MAGIC.size());
+    storeLE(header.data() + 8, VERSION);
+    storeLE(header.data() + 12, static_cast<std::uint32_t>(PuzzleCorpus::RECORD_SIZE));
+    storeLE(header.data() + 16, static_cast<std::uint64_t>(size_));
+    file.write(header.data(), header.size());
+
+    // Oldest first, so load() re-inserting in file order restores the recency list
+    for (std::uint32_t slot = oldest_; slot != NONE; slot = entries_[slot].prev) {
+        const Entry &entry = entries_[slot];
+        file.write(reinterpret_cast<const char *>(entry.key.data()), static_cast<std::streamsize>(entry.key.size()));
+        file.write(reinterpret_cast<const char *>(entry.solution.data()),
+                   static_cast<std::streamsize>(entry.solution.size()));
+    }
+    return static_cast<bool>(file.flush());
+}
+
+bool SolutionCache::load(const std::string &path) {
+    clear();
+    std::ifstream file(path, std::ios::binary);
+    std::array<char, HEADER_SIZE> header{};
+    if (!file.read(header.data(), header.size())) return false;
+    if (std::memcmp(header.data(), MAGIC.data(), MAGIC.size()) != 0 || loadLE<std::uint32_t>(header.data() + 8) != VERSION ||
+        loadLE<std::uint32_t>(header.data() + 12) != PuzzleCorpus::RECORD_SIZE)
+        return false;
+
+    const auto count = loadLE<std::uint64_t>(header.data() + 16);
+    const std::lock_guard lock(mutex_);
+    Record key{};
+    Record solution{};
+    for (std::uint64_t i = 0; i < count; ++i) {
+        if (!file.read(reinterpret_cast<char *>(key.data()), static_cast<std::streamsize>(key.size())) ||
+            !file.read(reinterpret_cast<char *>(solution.data()), static_cast<std::streamsize>(solution.size())))
+            return false;
+        // Hits go through BoardTransform::invert(), which only maps digits 0-9
+        if (!consistent(PuzzleCorpus::unpack(key), PuzzleCorpus::unpack(solution))) continue;
+        insertLocked(key, solution);
+    }
+    return true;
+}
@@ -0,0 +1,72 @@
+#include "SolverEngine.hpp"
+#include "BacktrackingEngines.hpp"
+#include "DlxSolver.hpp"
+
+namespace {
+    template<typename Engine>
+    std::unique_ptr<SolverEngine> make() {
+        return std::make_unique<Engine>();
+    }
+}
+
+// Engines without a counting mode share the propagation search
+template<int Box>
+std::uint64_t BasicSolverEngine<Box>::countSolutions(const Board &board, std::uint64_t limit) {
+    BasicPropagationEngine<Box> counter;
+    counter.setCancelToken(cancel_);
+    const std::uint64_t found = counter.countSolutions(board, limit);
+    stats_ = counter.stats();
+    return found;
+}
+
+// Engine table, indexed by EngineKind
+const std::array<SolverRegistry::Entry, 5> &SolverRegistry::engines() {
+    static const std::array<Entry, 5> table = {{
+        {EngineKind::Naive, "naive", "Naive backtracking", &make<NaiveEngine>},
+        {EngineKind::Bitmask, "bitmask", "Bitmask", &make<BitmaskEngine>},
+        {EngineKind::Mrv, "mrv", "MRV", &make<MrvEngine>},
+        {EngineKind::Propagation, "propagation", "Propagation + MRV", &make<PropagationEngine>},
+        {EngineKind::Dlx, "dlx", "Dancing Links", &make<DlxSolver>},
+    }};
+    return table;
+}
+
+const SolverRegistry::Entry &SolverRegistry::entry(EngineKind kind) {
+    return engines()[static_cast<size_t>(kind)];
+}
+
+const SolverRegistry::Entry *SolverRegistry::find(std::string_view id) {
+    for (const auto &e: engines())
+        if (e.id == id) return &e;
+    return nullptr;
+}
+
+std::unique_ptr<SolverEngine> SolverRegistry::create(EngineKind kind) {
+    return entry(kind).create();
+}
+
+template<int Box>
+std::unique_ptr<BasicSolverEngine<Box> > SolverRegistry::create(EngineKind kind) {
+    if constexpr (Box == 3) {
+        return create(kind);
+    } else {
+        switch (kind) {
+            case EngineKind::Naive: return std::make_unique<BasicNaiveEngine<Box> >();
+            case EngineKind::Bitmask: return std::make_unique<BasicBitmaskEngine<Box> >();
+            case EngineKind::Mrv: return std::make_unique<BasicMrvEngine<Box> >();
+            case EngineKind::Propagation:
+            case EngineKind::Dlx: break; // the exact-cover matrix is built for 9x9 only
+        }
+        return std::make_unique<BasicPropagationEngine<Box> >();
+    }
+}
+
+template class BasicSolverEngine<2>;
+template class BasicSolverEngine<3>;
+template class BasicSolverEngine<4>;
+template class BasicSolverEngine<5>;
+
+template std::unique_ptr<BasicSolverEngine<2> > SolverRegistry::create<2>(EngineKind);
+template std::unique_ptr<BasicSolverEngine<3> > SolverRegistry::create<3>(EngineKind);
+template std::unique_ptr<BasicSolverEngine<4> > SolverRegistry::create<4>(EngineKind);
+template std::unique_ptr<BasicSolverEngine<5> > SolverRegistry::create<5>(EngineKind);
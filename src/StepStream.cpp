@@ -0,0 +1,32 @@
+#include "StepStream.hpp"
+#include <chrono>
+#include <thread>
+
+template<int Box>
+void BasicStepStream<Box>::reset(const std::atomic<bool> *cancel) {
+    ring_.clear();
+    cancel_ = cancel;
+    solved_.store(false, std::memory_order_relaxed);
+    finished_.store(false, std::memory_order_relaxed);
+}
+
+// The display drains a few steps per frame, so a full ring means waiting milliseconds
+template<int Box>
+void BasicStepStream<Box>::push(const SolveStep &step) {
+    const typename Trace::Code code = Trace::encode(step);
+    while (!ring_.tryPush(code)) {
+        if (cancel_ != nullptr && cancel_->load(std::memory_order_relaxed)) return;
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+}
+
+template<int Box>
+void BasicStepStream<Box>::finish(bool solved) {
+    solved_.store(solved, std::memory_order_relaxed);
+    finished_.store(true, std::memory_order_release); // publishes solved_ and every pushed step
+}
+
+template class BasicStepStream<2>;
+template class BasicStepStream<3>;
+template class BasicStepStream<4>;
+template class BasicStepStream<5>;
@@ -1,7 +1,10 @@
 #include "Sudoku.hpp"
+#include <algorithm>
+#include "BacktrackingEngines.hpp"
+#include "SolutionCache.hpp"
 
 // Default puzzle (for initial load)
-const std::vector<std::vector<int> > Sudoku::DEFAULT_BOARD = {
+const Sudoku::Board Sudoku::DEFAULT_BOARD = {
     {8, 0, 0, 0, 0, 0, 0, 0, 0},
     {0, 0, 3, 6, 0, 0, 0, 0, 0},
     {0, 7, 0, 0, 9, 0, 2, 0, 0},
@@ -14,76 +17,108 @@ const std::vector<std::vector<int> > Sudoku::DEFAULT_BOARD = {
 };
 
 // Constructor / reset
-Sudoku::Sudoku(const std::vector<std::vector<int> > &inputBoard) {
+Sudoku::Sudoku(const Board &inputBoard) {
     reset(inputBoard);
 }
 
-void Sudoku::reset(const std::vector<std::vector<int> > &inputBoard) {
+Sudoku::~Sudoku() = default;
+
+void Sudoku::reset(const Board &inputBoard) {
     board_ = inputBoard;
-    given_.assign(SIZE, std::vector<bool>(SIZE, false));
-    for (size_t r = 0; r < SIZE; ++r)
-        for (size_t c = 0; c < SIZE; ++c)
-            given_[r][c] = (board_[r][c] != 0);
+    keyed_ = false;
+    cacheHit_ = false;
+    given_.reset();
+    for (size_t i = 0; i < static_cast<size_t>(Board::CELLS); ++i)
+        given_[i] = (board_.cells[i] != 0);
 }
 
-// Accessors removed - now inline in header with helper functions
-// This eliminates sign-conversion warnings from accessor calls
+// Engine selection - the instance is rebuilt lazily on the next solve
+void Sudoku::setEngine(EngineKind engine) {
+    if (engine == engineKind_) return;
+    engineKind_ = engine;
+    engine_.reset();
+}
 
-// Validity check: ensure placing 'num' at (row, col) doesn't violate Sudoku rules
-bool Sudoku::isValid(const int row, const int col, const int num) const {
-    // Check row and column using helper functions
-    for (int i = 0; i < SIZE; ++i) {
-        if (i != col && getFromBoard(board_, row, i) == num) return false;
-        if (i != row && getFromBoard(board_, i, col) == num) return false;
+SolverEngine &Sudoku::activeEngine() {
+    if (!engine_) {
+        engine_ = SolverRegistry::create(engineKind_);
+        engine_->setCancelToken(cancel_);
+        engine_->setProfiling(profile_);
     }
-    // Check 3x3 box
-    const int br = (row / GRID_SIZE) * GRID_SIZE;
-    const int bc = (col / GRID_SIZE) * GRID_SIZE;
-    for (int r = br; r < br + GRID_SIZE; ++r)
-        for (int c = bc; c < bc + GRID_SIZE; ++c)
-            if ((r != row || c != col) && getFromBoard(board_, r, c) == num) return false;
+    return *engine_;
+}
+
+void Sudoku::setCancelToken(const std::atomic<bool> *token) {
+    cancel_ = token;
+    if (engine_) engine_->setCancelToken(token);
+}
+
+void Sudoku::setProfiling(const bool enabled) {
+    profile_ = enabled;
+    if (engine_) engine_->setProfiling(enabled);
+}
+
+void Sudoku::setCache(SolutionCache *cache) {
+    cache_ = cache;
+    keyed_ = false;
+}
+
+// Cache lookup through the canonical form; solved boards and boards beyond the
+// canonicaliser's budget (nearly empty ones) are not cached
+bool Sudoku::solveFromCache() {
+    keyed_ = false;
+    cacheHit_ = false;
+    if (cache_ == nullptr || std::ranges::find(board_.cells, 0) == board_.cells.end()) return false;
+    if (!canonicalizer_) canonicalizer_ = std::make_unique<Canonicalizer>();
+    if (!canonicalizer_->canonicalize(board_, canonical_, transform_)) return false;
+    keyed_ = true;
+
+    const auto hit = cache_->find(canonical_);
+    if (!hit) return false;
+    board_ = transform_.invert(*hit);
+    keyed_ = false;
+    cacheHit_ = true;
     return true;
 }
 
+void Sudoku::cacheSolution(const Board &solution) {
+    if (cache_ != nullptr && keyed_) cache_->insert(canonical_, transform_.apply(solution));
+    keyed_ = false;
+}
+
+// Validity check: ensure placing 'num' at (row, col) doesn't violate Sudoku rules
+bool Sudoku::isValid(const int row, const int col, const int num) const {
+    return NaiveEngine::isValid(board_, row, col, num);
+}
+
 // Fast solve (without step tracking)
 bool Sudoku::solve() {
-    for (int r = 0; r < SIZE; ++r) {
-        for (int c = 0; c < SIZE; ++c) {
-            if (getFromBoard(board_, r, c) != 0) continue;
-            for (int num = 1; num <= 9; ++num) {
-                if (!isValid(r, c, num)) continue;
-                setToBoard(board_, r, c, num);
-                if (solve()) return true;
-                setToBoard(board_, r, c, 0); // backtrack
-            }
-            return false; // no number fits -> backtrack
-        }
-    }
-    return true; // all cells filled
+    if (solveFromCache()) return true;
+    const bool solved = activeEngine().solve(board_, nullptr);
+    if (solved) cacheSolution(board_);
+    return solved;
 }
 
 // Solve with step recording for animation
-bool Sudoku::solveRecursive(std::vector<SolveStep> &steps) {
-    for (int r = 0; r < SIZE; ++r) {
-        for (int c = 0; c < SIZE; ++c) {
-            if (getFromBoard(board_, r, c) != 0) continue;
-            for (int num = 1; num <= 9; ++num) {
-                if (!isValid(r, c, num)) continue;
-                setToBoard(board_, r, c, num);
-                steps.push_back({r, c, num}); // record placement
-                if (solveRecursive(steps)) return true;
-                setToBoard(board_, r, c, 0);
-                steps.push_back({r, c, 0}); // record removal (backtrack)
-            }
-            return false;
-        }
-    }
-    return true;
-}
-
 bool Sudoku::solveWithSteps(std::vector<SolveStep> &steps) {
     steps.clear();
-    return solveRecursive(steps);
+    cacheHit_ = false;
+    VectorStepSink sink(steps);
+    return activeEngine().solve(board_, &sink);
 }
 
+// Solve streaming steps to a consumer
+bool Sudoku::solveWithSteps(StepSink &sink) {
+    cacheHit_ = false;
+    return activeEngine().solve(board_, &sink);
+}
 
+// Solution counting (board untouched)
+std::uint64_t Sudoku::countSolutions(const std::uint64_t limit) {
+    cacheHit_ = false;
+    return activeEngine().countSolutions(board_, limit);
+}
+
+bool Sudoku::hasUniqueSolution() {
+    return countSolutions(2) == 1;
+}
@@ -1,111 +1,102 @@
 #include "SudokuCell.hpp"
 #include <QPainter>
-#include <QMouseEvent>
+#include <algorithm>
+#include <array>
+#include "SudokuBoard.hpp"
 
-SudokuCell::SudokuCell(int row, int col, QWidget *parent)
-    : QWidget(parent),
-      row_(row),
-      col_(col),
-      value_(0),
-      state_(CellState::Empty),
-      selected_(false),
-      highlighted_(false)
+namespace
 {
-    setFixedSize(56, 56);
-    setCursor(Qt::PointingHandCursor);
-    setAttribute(Qt::WA_OpaquePaintEvent);
+    // Colours as QRgb constants: no hex string parsing while painting
+    constexpr QRgb SELECTED_BG = 0xFFFFF176;    // bright yellow - selected
+    constexpr QRgb HIGHLIGHTED_BG = 0xFFE8EAF6; // light indigo - highlighted
+    constexpr QRgb NORMAL_BG = 0xFFFAFAFA;      // off-white - normal
+    constexpr QRgb BORDER = 0xFFCFD8DC;         // light border
+
+    // Digit colour per CellState (indexed by the enum value)
+    constexpr std::array<QRgb, CELL_STATE_COUNT> TEXT_COLORS = {
+        0xFF212121, // Empty
+        0xFF1565C0, // Given - deep blue
+        0xFF37474F, // UserInput - dark blue-gray
+        0xFF2E7D32, // Solved - deep green
+        0xFF00838F, // Deduced - dark cyan
+        0xFFE53935, // Backtrack - red
+        0xFFE53935, // Invalid - red
+    };
 }
 
-void SudokuCell::setValue(int val, CellState state)
+bool SudokuCell::setValue(int val, CellState state)
 {
+    if (value_ == val && state_ == state)
+        return false;
     value_ = val;
     state_ = state;
-    update();
+    return true;
 }
 
-void SudokuCell::setSelected(bool sel)
+bool SudokuCell::setSelected(bool sel)
 {
     if (selected_ == sel)
-        return;
+        return false;
     selected_ = sel;
-    update();
+    return true;
 }
 
-void SudokuCell::setHighlighted(bool h)
+bool SudokuCell::setHighlighted(bool h)
 {
     if (highlighted_ == h)
-        return;
+        return false;
     highlighted_ = h;
-    update();
+    return true;
 }
 
-void SudokuCell::paintEvent(QPaintEvent *)
+QPixmap SudokuCell::renderGlyphs(int cellSize, int digits, qreal dpr)
 {
-    QPainter p(this);
-    p.setRenderHint(QPainter::Antialiasing, false);
-
-    // Background color based on state
-    QColor bg;
-    if (selected_)
-        bg = QColor("#FFF176"); // bright yellow - selected
-    else if (highlighted_)
-        bg = QColor("#E8EAF6"); // light indigo - highlighted
-    else
-        bg = QColor("#FAFAFA"); // off-white - normal
+    QPixmap atlas(QSize(digits * cellSize, CELL_STATE_COUNT * cellSize) * dpr);
+    atlas.setDevicePixelRatio(dpr);
+    atlas.fill(Qt::transparent);
 
-    p.fillRect(rect(), bg);
+    QPainter p(&atlas);
+    p.setRenderHint(QPainter::TextAntialiasing);
 
-    // Draw cell value
-    if (value_ != 0)
-    {
-        // Static font cache (created once, reused every frame)
-        static QFont font = []()
-        {
+    // Font is only needed here; every frame afterwards just blits
+    // (21 pt on the 56 px cells of a 9x9 grid, scaled with the cell size)
+    const int pointSize = std::max(7, cellSize * 3 / 8);
 #if defined(Q_OS_MAC)
-            QFont f("SF Pro Text", 21, QFont::Bold);
+    QFont font("SF Pro Text", pointSize, QFont::Bold);
 #elif defined(Q_OS_WIN)
-            QFont f("Segoe UI", 21, QFont::Bold);
+    QFont font("Segoe UI", pointSize, QFont::Bold);
 #else
-            QFont f("Ubuntu", 21, QFont::Bold);
+    QFont font("Ubuntu", pointSize, QFont::Bold);
 #endif
-            f.setStyleHint(QFont::SansSerif);
-            return f;
-        }();
-        p.setFont(font);
+    font.setStyleHint(QFont::SansSerif);
+    p.setFont(font);
 
-        // Color based on cell state
-        QColor textColor;
-        switch (state_)
-        {
-        case CellState::Given:
-            textColor = QColor("#1565C0"); // deep blue
-            break;
-        case CellState::UserInput:
-            textColor = QColor("#37474F"); // dark blue-gray
-            break;
-        case CellState::Solved:
-            textColor = QColor("#2E7D32"); // deep green
-            break;
-        case CellState::Backtrack:
-            textColor = QColor("#E53935"); // red
-            break;
-        case CellState::Invalid:
-            textColor = QColor("#E53935"); // red
-            break;
-        default:
-            textColor = QColor("#212121");
-        }
-        p.setPen(textColor);
-        p.drawText(rect(), Qt::AlignCenter, QString::number(value_));
+    for (int s = 0; s < CELL_STATE_COUNT; ++s)
+    {
+        p.setPen(QColor::fromRgb(TEXT_COLORS[static_cast<size_t>(s)]));
+        for (int d = 1; d <= digits; ++d)
+            p.drawText(QRect((d - 1) * cellSize, s * cellSize, cellSize, cellSize), Qt::AlignCenter,
+                       QString(QChar::fromLatin1(cellSymbol(d))));
     }
-
-    // Light border
-    p.setPen(QPen(QColor("#CFD8DC"), 1));
-    p.drawRect(0, 0, width() - 1, height() - 1);
+    return atlas;
 }
 
-void SudokuCell::mousePressEvent(QMouseEvent *event)
+void SudokuCell::paint(QPainter &p, const QRect &rect, const QPixmap &glyphs) const
 {
-    if (event->button() == Qt::LeftButton)
-        emit cellClicked(row_, col_);
+    // Background color based on state
+    const QRgb bg = selected_ ? SELECTED_BG : highlighted_ ? HIGHLIGHTED_BG : NORMAL_BG;
+    p.fillRect(rect, QColor::fromRgb(bg));
+
+    // Draw cell value: copy the pre-rendered digit (source is in device pixels)
+    if (value_ != 0)
+    {
+        const qreal dpr = glyphs.devicePixelRatio();
+        const QRectF source((value_ - 1) * rect.width() * dpr, static_cast<int>(state_) * rect.height() * dpr,
+                            rect.width() * dpr, rect.height() * dpr);
+        p.drawPixmap(QPointF(rect.topLeft()), glyphs, source);
+    }
+
+    // Light border
+    p.setPen(QColor::fromRgb(BORDER));
+    p.drawRect(rect.adjusted(0, 0, -1, -1));
 }
@@ -1,196 +1,234 @@
 #include "SudokuGrid.hpp"
 #include <QPainter>
+#include <QPaintEvent>
 #include <QKeyEvent>
+#include <QMouseEvent>
 
 // Cell coordinate calculation
-// idx ∈ [0,8]
-// Every 3 cells form one 3x3 box
+// idx ∈ [0, size_ - 1]
+// Every box_ cells form one box
 // Inner gap: THIN_GAP, box gap: THICK_GAP
-int SudokuGrid::cellX(int col) {
-    const int box = col / 3;
-    const int inBox = col % 3;
-    return PADDING + box * (BOX_SPAN + THICK_GAP) + inBox * (CELL_SIZE + THIN_GAP);
+int SudokuGrid::cellX(int col) const {
+    const int box = col / box_;
+    const int inBox = col % box_;
+    return PADDING + box * (boxSpan_ + THICK_GAP) + inBox * (cellSize_ + THIN_GAP);
 }
 
-int SudokuGrid::cellY(int row) {
-    const int box = row / 3;
-    const int inBox = row % 3;
-    return PADDING + box * (BOX_SPAN + THICK_GAP) + inBox * (CELL_SIZE + THIN_GAP);
+int SudokuGrid::cellY(int row) const {
+    const int box = row / box_;
+    const int inBox = row % box_;
+    return PADDING + box * (boxSpan_ + THICK_GAP) + inBox * (cellSize_ + THIN_GAP);
+}
+
+// Inverse of cellX/cellY: split into box and cell-in-box, reject gaps
+int SudokuGrid::cellAt(int pos) const {
+    const int offset = pos - PADDING;
+    if (offset < 0 || offset >= content_) return -1;
+
+    const int box = offset / (boxSpan_ + THICK_GAP);
+    const int inBox = offset % (boxSpan_ + THICK_GAP);
+    if (inBox >= boxSpan_) return -1; // thick gap
+
+    const int inCell = inBox % (cellSize_ + THIN_GAP);
+    if (inCell >= cellSize_) return -1; // thin gap
+    return box * box_ + inBox / (cellSize_ + THIN_GAP);
+}
+
+QRect SudokuGrid::cellRect(int row, int col) const {
+    return {cellX(col), cellY(row), cellSize_, cellSize_};
+}
+
+// Layout of a box_ x box_ arrangement of boxes; the widget resizes with it
+void SudokuGrid::setBoxSize(int box) {
+    if (box == box_) return;
+    box_ = box;
+    size_ = box * box;
+    cellSize_ = CELL_SIZES[static_cast<size_t>(box - 2)];
+    boxSpan_ = box * cellSize_ + (box - 1) * THIN_GAP;
+    content_ = box * boxSpan_ + (box - 1) * THICK_GAP;
+    widgetSize_ = content_ + 2 * PADDING;
+
+    cells_.assign(static_cast<size_t>(size_ * size_), SudokuCell{});
+    initial_.assign(cells_.size(), 0);
+    glyphs_ = QPixmap(); // digit columns and tile size changed
+    setFixedSize(widgetSize_, widgetSize_);
+    update();
+}
+
+void SudokuGrid::repaintCell(int row, int col) {
+    update(cellRect(row, col));
 }
 
 // Constructor
 SudokuGrid::SudokuGrid(QWidget *parent) : QWidget(parent) {
-    setFixedSize(WIDGET_SZ, WIDGET_SZ);
     setFocusPolicy(Qt::StrongFocus);
-
-    for (size_t r = 0; r < 9; ++r) {
-        for (size_t c = 0; c < 9; ++c) {
-            auto *cell = new SudokuCell(static_cast<int>(r), static_cast<int>(c), this);
-            connect(cell, &SudokuCell::cellClicked, this, &SudokuGrid::onCellClicked);
-            cell->move(cellX(static_cast<int>(c)), cellY(static_cast<int>(r)));
-            cells_[r][c] = cell;
-        }
-    }
+    setCursor(Qt::PointingHandCursor);
+    setAttribute(Qt::WA_OpaquePaintEvent);
 
     loadBoard(Sudoku::DEFAULT_BOARD);
 }
 
 // Load new puzzle board
-void SudokuGrid::loadBoard(const std::vector<std::vector<int> > &board) {
-    initialBoard_ = board;
+void SudokuGrid::loadCells(int box, std::span<const std::uint8_t> values) {
+    setBoxSize(box);
+    initial_.assign(values.begin(), values.end());
     selectedRow_ = -1;
     selectedCol_ = -1;
 
-    for (size_t r = 0; r < 9; ++r) {
-        for (size_t c = 0; c < 9; ++c) {
-            const int val = board[r][c];
-            cells_[r][c]->setValue(val, val != 0 ? CellState::Given : CellState::Empty);
-            cells_[r][c]->setSelected(false);
-            cells_[r][c]->setHighlighted(false);
+    for (int r = 0; r < size_; ++r)
+        for (int c = 0; c < size_; ++c) {
+            auto &target = cell(r, c);
+            const int val = initial_[static_cast<size_t>(r * size_ + c)];
+            // Non-short-circuit |: every setter must run
+            if (target.setValue(val, val != 0 ? CellState::Given : CellState::Empty)
+                | target.setSelected(false) | target.setHighlighted(false))
+                repaintCell(r, c);
         }
-    }
 }
 
 // Apply a solving step
 void SudokuGrid::applyStep(const SolveStep &step) {
-    auto *cell = cells_[static_cast<size_t>(step.row)][static_cast<size_t>(step.col)];
+    bool changed;
     if (step.value == 0) {
-        cell->setValue(0, CellState::Empty);
+        changed = cell(step.row, step.col).setValue(0, CellState::Empty);
     } else {
         // Don't override given cell state
-        const bool given = (initialBoard_[static_cast<size_t>(step.row)][static_cast<size_t>(step.col)] != 0);
-        cell->setValue(step.value, given ? CellState::Given : CellState::Solved);
+        const bool given = (initial_[static_cast<size_t>(step.row * size_ + step.col)] != 0);
+        const CellState solved = step.kind == StepKind::Deduced ? CellState::Deduced : CellState::Solved;
+        changed = cell(step.row, step.col).setValue(step.value, given ? CellState::Given : solved);
     }
+    if (changed) repaintCell(step.row, step.col);
 }
 
-// Mark all solved cells
+// Mark all solved cells (deduced cells keep their own colour)
 void SudokuGrid::markSolved() {
-    for (size_t r = 0; r < 9; ++r)
-        for (size_t c = 0; c < 9; ++c)
-            if (cells_[r][c]->state() != CellState::Given && cells_[r][c]->value() != 0)
-                cells_[r][c]->setValue(cells_[r][c]->value(), CellState::Solved);
+    for (int r = 0; r < size_; ++r)
+        for (int c = 0; c < size_; ++c) {
+            auto &target = cell(r, c);
+            if (target.state() != CellState::Given && target.state() != CellState::Deduced && target.value() != 0
+                && target.setValue(target.value(), CellState::Solved))
+                repaintCell(r, c);
+        }
 }
 
 // Clear user inputs
 void SudokuGrid::clearUserInput() {
     selectedRow_ = -1;
     selectedCol_ = -1;
-    for (size_t r = 0; r < 9; ++r) {
-        for (size_t c = 0; c < 9; ++c) {
-            cells_[r][c]->setSelected(false);
-            cells_[r][c]->setHighlighted(false);
-            if (initialBoard_[r][c] == 0)
-                cells_[r][c]->setValue(0, CellState::Empty);
+    for (int r = 0; r < size_; ++r)
+        for (int c = 0; c < size_; ++c) {
+            auto &target = cell(r, c);
+            bool changed = target.setSelected(false) | target.setHighlighted(false);
+            if (initial_[static_cast<size_t>(r * size_ + c)] == 0)
+                changed |= target.setValue(0, CellState::Empty);
+            if (changed) repaintCell(r, c);
         }
-    }
-}
-
-// Get current board state
-std::vector<std::vector<int> > SudokuGrid::getCurrentBoard() const {
-    std::vector<std::vector<int> > board(9, std::vector<int>(9, 0));
-    for (size_t r = 0; r < 9; ++r)
-        for (size_t c = 0; c < 9; ++c)
-            board[r][c] = cells_[r][c]->value();
-    return board;
 }
 
-// Handle cell click
-void SudokuGrid::onCellClicked(int row, int col) {
-    // Remove previous selection
-    if (selectedRow_ != -1)
-        cells_[static_cast<size_t>(selectedRow_)][static_cast<size_t>(selectedCol_)]->setSelected(false);
-
-    // Clear all highlights
-    for (size_t r = 0; r < 9; ++r)
-        for (size_t c = 0; c < 9; ++c)
-            cells_[r][c]->setHighlighted(false);
+// Select a cell; only cells whose look changes are repainted
+void SudokuGrid::selectCell(int row, int col) {
+    if (selectedRow_ != -1 && cell(selectedRow_, selectedCol_).setSelected(false))
+        repaintCell(selectedRow_, selectedCol_);
 
     selectedRow_ = row;
     selectedCol_ = col;
-    cells_[static_cast<size_t>(row)][static_cast<size_t>(col)]->setSelected(true);
+    if (cell(row, col).setSelected(true))
+        repaintCell(row, col);
 
     updateHighlights(row, col);
     setFocus();
 }
 
-// Update highlighted cells
+// Update highlighted cells: same row, column or box as the selection
 void SudokuGrid::updateHighlights(int row, int col) {
-    // Collect cells to highlight
-    std::vector<SudokuCell *> toHighlight;
-    toHighlight.reserve(27);
-
-    // Same row and column
-    for (int i = 0; i < 9; ++i) {
-        if (i != col && cells_[static_cast<size_t>(row)][static_cast<size_t>(i)] != nullptr)
-            toHighlight.push_back(cells_[static_cast<size_t>(row)][static_cast<size_t>(i)]);
-        if (i != row && cells_[static_cast<size_t>(i)][static_cast<size_t>(col)] != nullptr)
-            toHighlight.push_back(cells_[static_cast<size_t>(i)][static_cast<size_t>(col)]);
-    }
-
-    // Same 3x3 box
-    const int br = (row / 3) * 3;
-    const int bc = (col / 3) * 3;
-    for (int r = br; r < br + 3; ++r) {
-        for (int c = bc; c < bc + 3; ++c) {
-            if ((r != row || c != col) && cells_[static_cast<size_t>(r)][static_cast<size_t>(c)] != nullptr)
-                toHighlight.push_back(cells_[static_cast<size_t>(r)][static_cast<size_t>(c)]);
+    for (int r = 0; r < size_; ++r)
+        for (int c = 0; c < size_; ++c) {
+            const bool sameBox = r / box_ == row / box_ && c / box_ == col / box_;
+            const bool related = row >= 0 && (r == row || c == col || sameBox);
+            const bool self = r == row && c == col;
+            if (cell(r, c).setHighlighted(related && !self))
+                repaintCell(r, c);
         }
-    }
+}
 
-    // Batch update
-    for (auto *cell: toHighlight) {
-        cell->setHighlighted(true);
-    }
+// Handle mouse click: hit-test against the layout, ignore gaps
+void SudokuGrid::mousePressEvent(QMouseEvent *event) {
+    if (event->button() != Qt::LeftButton) return;
+    const QPoint pos = event->position().toPoint();
+    const int row = cellAt(pos.y());
+    const int col = cellAt(pos.x());
+    if (row >= 0 && col >= 0)
+        selectCell(row, col);
 }
 
 // Handle keyboard input
 void SudokuGrid::keyPressEvent(QKeyEvent *event) {
     if (selectedRow_ == -1) return;
 
-    auto *cell = cells_[static_cast<size_t>(selectedRow_)][static_cast<size_t>(selectedCol_)];
+    auto &target = cell(selectedRow_, selectedCol_);
     const int key = event->key();
-
-    // 1-9: number input (don't touch given cells)
-    if (key >= Qt::Key_1 && key <= Qt::Key_9) {
-        if (cell->state() != CellState::Given)
-            cell->setValue(key - Qt::Key_0, CellState::UserInput);
+    bool changed = false;
+
+    // 1-9, then A-P on larger boards: number input (don't touch given cells)
+    const int digit = key >= Qt::Key_1 && key <= Qt::Key_9   ? key - Qt::Key_0
+                      : key >= Qt::Key_A && key <= Qt::Key_P ? key - Qt::Key_A + 10
+                                                             : 0;
+    if (digit != 0 && digit <= size_) {
+        if (target.state() != CellState::Given)
+            changed = target.setValue(digit, CellState::UserInput);
     }
     // Delete
     else if (key == Qt::Key_Backspace || key == Qt::Key_Delete) {
-        if (cell->state() != CellState::Given)
-            cell->setValue(0, CellState::Empty);
+        if (target.state() != CellState::Given)
+            changed = target.setValue(0, CellState::Empty);
     }
     // Arrow navigation
-    else if (key == Qt::Key_Up && selectedRow_ > 0) onCellClicked(selectedRow_ - 1, selectedCol_);
-    else if (key == Qt::Key_Down && selectedRow_ < 8) onCellClicked(selectedRow_ + 1, selectedCol_);
-    else if (key == Qt::Key_Left && selectedCol_ > 0) onCellClicked(selectedRow_, selectedCol_ - 1);
-    else if (key == Qt::Key_Right && selectedCol_ < 8) onCellClicked(selectedRow_, selectedCol_ + 1);
+    else if (key == Qt::Key_Up && selectedRow_ > 0) selectCell(selectedRow_ - 1, selectedCol_);
+    else if (key == Qt::Key_Down && selectedRow_ < size_ - 1) selectCell(selectedRow_ + 1, selectedCol_);
+    else if (key == Qt::Key_Left && selectedCol_ > 0) selectCell(selectedRow_, selectedCol_ - 1);
+    else if (key == Qt::Key_Right && selectedCol_ < size_ - 1) selectCell(selectedRow_, selectedCol_ + 1);
+
+    if (changed) repaintCell(selectedRow_, selectedCol_);
 }
 
-// Paint grid lines and separators
-void SudokuGrid::paintEvent(QPaintEvent *) {
+// Paint grid lines, separators and the cells inside the update region
+void SudokuGrid::paintEvent(QPaintEvent *event) {
     QPainter p(this);
     p.setRenderHint(QPainter::Antialiasing, false);
 
     // General background (light gray for thin gaps)
     p.fillRect(rect(), QColor("#B0BEC5"));
 
-    // 3x3 box separator color (dark indigo)
+    // Box separator color (dark indigo)
     const QColor boxSep("#3949AB");
 
-    // Vertical box separators (between columns 2-3 and 5-6)
-    for (int i = 1; i <= 2; ++i) {
-        const int xSep = cellX(i * 3) - THICK_GAP;
-        p.fillRect(xSep, PADDING, THICK_GAP, CONTENT, boxSep);
+    // Vertical box separators (between the last column of a box and the next)
+    for (int i = 1; i < box_; ++i) {
+        const int xSep = cellX(i * box_) - THICK_GAP;
+        p.fillRect(xSep, PADDING, THICK_GAP, content_, boxSep);
     }
 
-    // Horizontal box separators (between rows 2-3 and 5-6)
-    for (int i = 1; i <= 2; ++i) {
-        const int ySep = cellY(i * 3) - THICK_GAP;
-        p.fillRect(PADDING, ySep, CONTENT, THICK_GAP, boxSep);
+    // Horizontal box separators
+    for (int i = 1; i < box_; ++i) {
+        const int ySep = cellY(i * box_) - THICK_GAP;
+        p.fillRect(PADDING, ySep, content_, THICK_GAP, boxSep);
     }
 
     // Outer border
     p.setPen(QPen(boxSep, 3));
-    p.drawRect(2, 2, WIDGET_SZ - 5, WIDGET_SZ - 5);
+    p.drawRect(2, 2, widgetSize_ - 5, widgetSize_ - 5);
+
+    // Digit atlas follows the board size and the screen the widget is on
+    const qreal dpr = devicePixelRatioF();
+    if (glyphs_.isNull() || glyphs_.devicePixelRatio() != dpr)
+        glyphs_ = SudokuCell::renderGlyphs(cellSize_, size_, dpr);
+
+    // Cells, one pass over the flat model (Qt clips to the update region)
+    const QRegion &dirty = event->region();
+    for (int r = 0; r < size_; ++r)
+        for (int c = 0; c < size_; ++c) {
+            const QRect area = cellRect(r, c);
+            if (dirty.intersects(area))
+                cell(r, c).paint(p, area, glyphs_);
+        }
 }
@@ -0,0 +1,113 @@
+#include "ThreadPool.hpp"
+#include <algorithm>
+
+namespace {
+    thread_local int tlsWorker = -1; ///< Index of the pool worker running on this thread
+}
+
+ThreadPool::ThreadPool(std::size_t threads) {
+    if (threads == 0) threads = std::max<std::size_t>(1, std::thread::hardware_concurrency());
+
+    workers_.reserve(threads);
+    for (std::size_t i = 0; i < threads; ++i)
+        workers_.push_back(std::make_unique<Worker>());
+
+    threads_.reserve(threads);
+    for (std::size_t i = 0; i < threads; ++i)
+        threads_.emplace_back([this, i] { run(i); });
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard lock(sleepMutex_);
+        stop_ = true;
+    }
+    wake_.notify_all();
+    for (auto &thread: threads_)
+        thread.join();
+}
+
+void ThreadPool::Worker::pushBack(Task &&task) {
+    if (tail - head == ring.size()) {
+        // Full: unroll into a ring twice the size, oldest task first
+        std::vector<Task> grown(ring.size() * 2);
+        for (std::size_t i = 0; i < ring.size(); ++i)
+            grown[i] = std::move(ring[(head + i) & (ring.size() - 1)]);
+        tail -= head;
+        head = 0;
+        ring.swap(grown);
+    }
+    ring[tail++ & (ring.size() - 1)] = std::move(task);
+}
+
+void ThreadPool::Worker::popBack(Task &task) {
+    Task &slot = ring[--tail & (ring.size() - 1)];
+    task = std::move(slot);
+    slot = nullptr;
+}
+
+void ThreadPool::Worker::popFront(Task &task) {
+    Task &slot = ring[head++ & (ring.size() - 1)];
+    task = std::move(slot);
+    slot = nullptr;
+}
+
+int ThreadPool::currentWorker() {
+    return tlsWorker;
+}
+
+void ThreadPool::submit(Task task) {
+    // Workers keep their own subtasks local; outside callers spread round-robin
+    const std::size_t target = tlsWorker >= 0 && static_cast<std::size_t>(tlsWorker) < workers_.size()
+                                   ? static_cast<std::size_t>(tlsWorker)
+                                   : nextQueue_.fetch_add(1, std::memory_order_relaxed) % workers_.size();
+    {
+        // Count first (under the sleep lock so no worker misses the wake-up), then publish;
+        // a worker that wakes in between simply retries until the task is visible
+        std::lock_guard lock(sleepMutex_);
+        pending_.fetch_add(1, std::memory_order_release);
+    }
+    {
+        std::lock_guard lock(workers_[target]->mutex);
+        workers_[target]->pushBack(std::move(task));
+    }
+    wake_.notify_one();
+}
+
+bool ThreadPool::acquire(std::size_t self, Task &task) {
+    // Own deque first, newest task (LIFO)
+    {
+        Worker &own = *workers_[self];
+        std::lock_guard lock(own.mutex);
+        if (!own.empty()) {
+            own.popBack(task);
+            return true;
+        }
+    }
+    // Steal the oldest task (FIFO) from a sibling
+    for (std::size_t k = 1; k < workers_.size(); ++k) {
+        Worker &victim = *workers_[(self + k) % workers_.size()];
+        std::lock_guard lock(victim.mutex);
+        if (!victim.empty()) {
+            victim.popFront(task);
+            return true;
+        }
+    }
+    return false;
+}
+
+void ThreadPool::run(std::size_t index) {
+    tlsWorker = static_cast<int>(index);
+    Task task;
+    for (;;) {
+        if (acquire(index, task)) {
+            pending_.fetch_sub(1, std::memory_order_acq_rel);
+            task();
+            task = nullptr;
+            continue;
+        }
+        std::unique_lock lock(sleepMutex_);
+        wake_.wait(lock, [this] { return stop_ || pending_.load(std::memory_order_acquire) > 0; });
+        if (stop_ && pending_.load(std::memory_order_acquire) == 0) return;
+    }
+}
@@ -0,0 +1,80 @@
+#include "TracePlayer.hpp"
+#include <algorithm>
+
+template<int Box>
+BasicTracePlayer<Box>::BasicTracePlayer(std::size_t interval)
+    : interval_(std::max<std::size_t>(1, interval)) {
+    reset(Board{});
+}
+
+template<int Box>
+void BasicTracePlayer<Box>::reset(const Board &start) {
+    trace_.clear();
+    recordHead_ = {start, {}};
+    frame_ = recordHead_;
+    position_ = 0;
+    snapshots_.assign(1, recordHead_);
+}
+
+template<int Box>
+void BasicTracePlayer<Box>::apply(Frame &frame, const SolveStep &step) {
+    frame.board.set(step.row, step.col, step.value);
+    frame.deduced[static_cast<size_t>(Board::index(step.row, step.col))] =
+            step.value != 0 && step.kind == StepKind::Deduced;
+}
+
+template<int Box>
+void BasicTracePlayer<Box>::append(const SolveStep &step) {
+    trace_.push(step);
+    apply(recordHead_, step);
+    if (trace_.size() % interval_ == 0) snapshots_.push_back(recordHead_);
+}
+
+template<int Box>
+SolveStep BasicTracePlayer<Box>::stepForward() {
+    const SolveStep next = step(position_);
+    apply(frame_, next);
+    ++position_;
+    return next;
+}
+
+// Replay from the closest snapshot, or just continue when moving forward a little
+template<int Box>
+void BasicTracePlayer<Box>::seek(std::size_t target) {
+    target = std::min(target, size());
+    if (target < position_ || target - position_ >= interval_) {
+        const std::size_t k = target / interval_;
+        frame_ = snapshots_[k];
+        position_ = k * interval_;
+    }
+    while (position_ < target) stepForward();
+}
+
+template<int Box>
+std::size_t BasicTracePlayer<Box>::advance(std::size_t count, Cells &touched,
+                                           std::chrono::steady_clock::time_point deadline) {
+    const std::size_t start = position_;
+    const std::size_t target = std::min(size(), position_ + std::min(count, size()));
+
+    // Far jumps: a snapshot is cheaper than replaying, and nearly every cell changes anyway
+    if (target - position_ >= 2 * interval_) {
+        seek(target);
+        touched.set();
+        return target - start;
+    }
+
+    while (position_ < target) {
+        const std::size_t stride = std::min(target, position_ + CLOCK_STRIDE);
+        while (position_ < stride) {
+            const SolveStep applied = stepForward();
+            touched.set(static_cast<size_t>(Board::index(applied.row, applied.col)));
+        }
+        if (position_ < target && std::chrono::steady_clock::now() >= deadline) break;
+    }
+    return position_ - start;
+}
+
+template class BasicTracePlayer<2>;
+template class BasicTracePlayer<3>;
+template class BasicTracePlayer<4>;
+template class BasicTracePlayer<5>;
@@ -0,0 +1,328 @@
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "DifficultyRater.hpp"
+#include "PuzzleCorpus.hpp"
+#include "SolutionCache.hpp"
+#include "Sudoku.hpp"
+#include "ThreadPool.hpp"
+
+namespace {
+    /**
+     * @struct WorkerContext
+     * @brief Solver state owned by one pool worker (no sharing, no locking)
+     */
+    struct WorkerContext {
+        Sudoku sudoku; ///< Reused solver and engine scratch buffers
+        DifficultyRater rater; ///< Grades solved puzzles (--rate)
+    };
+
+    /**
+     * @struct Settings
+     * @brief Read-only state shared by all chunks of a run
+     */
+    struct Settings {
+        std::vector<WorkerContext> contexts; ///< One per pool worker
+        bool timing{true}; ///< Append per-puzzle microseconds
+        bool unique{false}; ///< Reject puzzles with more than one solution
+        bool rate{false}; ///< Append the difficulty rating of solved puzzles
+        const PuzzleCorpus *corpus{nullptr}; ///< Binary input (null: text lines)
+    };
+
+    /**
+     * @struct Chunk
+     * @brief A run of consecutive input lines solved by one task
+     * @details Chunks are recycled round-robin through the reorder buffer; lines and
+     *          output keep their capacity, so a warmed-up run does not allocate
+     */
+    struct Chunk {
+        Settings *settings{nullptr}; ///< Shared run state (the task captures only the chunk)
+        std::vector<std::string> lines; ///< Input puzzles, the first count are in use (text input)
+        std::size_t first{0}; ///< Index of the first record (corpus input)
+        std::size_t count{0}; ///< Puzzles in use
+        std::string output; ///< Formatted result lines, in input order
+        std::size_t solved{0}; ///< Puzzles solved
+        std::size_t failed{0}; ///< Invalid, unsolvable or ambiguous puzzles
+        std::chrono::nanoseconds solveTime{0}; ///< Sum of per-puzzle solve times
+        std::atomic<bool> done{false}; ///< Set (and notified) by the worker when output is ready
+    };
+
+    /**
+     * @brief Solve every puzzle of a chunk and format its output
+     * @param chunk Chunk to process
+     * @param context Solver state owned by the calling worker
+     */
+    void solveChunk(Chunk &chunk, WorkerContext &context) {
+        const Settings &settings = *chunk.settings;
+        Sudoku &sudoku = context.sudoku;
+        SudokuBoard puzzle;
+        chunk.output.clear();
+        chunk.output.reserve(chunk.count * 96);
+        for (std::size_t i = 0; i < chunk.count; ++i) {
+            // Corpus records are only checked here: open() validates the header, not the cells
+            const bool valid = settings.corpus != nullptr ? settings.corpus->valid(chunk.first + i)
+                                                          : SudokuBoard::parse(chunk.lines[i], puzzle);
+            if (!valid) {
+                ++chunk.failed;
+                chunk.output += "invalid\n";
+                continue;
+            }
+            if (settings.corpus != nullptr) puzzle = settings.corpus->at(chunk.first + i);
+
+            sudoku.reset(puzzle);
+            const auto start = std::chrono::steady_clock::now();
+            const std::uint64_t solutions = settings.unique ? sudoku.countSolutions(2) : 1;
+            const bool ok = solutions == 1 && sudoku.solve();
+            const auto elapsed = std::chrono::steady_clock::now() - start;
+            chunk.solveTime += elapsed;
+
+            if (ok) {
+                ++chunk.solved;
+                sudoku.board().appendTo(chunk.output);
+                if (settings.rate) {
+                    const Rating rating = context.rater.rate(puzzle);
+                    char digits[24];
+                    const auto end = std::to_chars(digits, digits + sizeof digits, rating.score,
+                                                   std::chars_format::fixed, 1).ptr;
+                    chunk.output += '\t';
+                    chunk.output.append(digits, end);
+                    chunk.output += '\t';
+                    chunk.output += DifficultyRater::name(rating.difficulty);
+                    chunk.output += '\t';
+                    chunk.output += DifficultyRater::name(rating.hardest);
+                }
+            } else {
+                ++chunk.failed;
+                puzzle.appendTo(chunk.output);
+                chunk.output += solutions > 1 ? "\tmultiple" : "\tunsolvable";
+            }
+            if (settings.timing) {
+                char digits[24];
+                const auto us = std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count();
+                const auto end = std::to_chars(digits, digits + sizeof digits, us).ptr;
+                chunk.output += '\t';
+                chunk.output.append(digits, end);
+            }
+            chunk.output += '\n';
+        }
+    }
+
+    /// Print command-line help
+    void printUsage(const char *program) {
+        std::cerr << "Usage: " << program << " [--engine ID] [--threads N] [--chunk N] [--unique] [--rate] [--cache FILE] [--no-timing] [FILE | -]\n"
+                  << "  Reads puzzles in the 81-character format (one per line, '.' or '0' = empty)\n"
+                  << "  from FILE or stdin, or records of a binary corpus FILE (see sudoku_corpus),\n"
+                  << "  and writes one line per puzzle to stdout, in input order:\n"
+                  << "    <solution>\\t<microseconds>   solved\n"
+                  << "    <puzzle>\\tunsolvable\\t<us>   no solution\n"
+                  << "    <puzzle>\\tmultiple\\t<us>     more than one solution (--unique only)\n"
+                  << "    invalid                       malformed input line or damaged corpus record\n"
+                  << "  With --rate, solved lines carry <score>\\t<difficulty>\\t<hardest technique>\n"
+                  << "  before the time (see DifficultyRater).\n"
+                  << "  --threads N  worker threads (default: all hardware threads)\n"
+                  << "  --chunk N    puzzles per task (default: 64)\n"
+                  << "  --unique     check that every puzzle has exactly one solution\n"
+                  << "  --rate       grade solved puzzles by the human techniques they need\n"
+                  << "  --cache FILE reuse solutions of symmetric copies of earlier puzzles, kept in FILE\n"
+                  << "               across runs (created if missing; see SolutionCache)\n"
+                  << "  Engines:";
+        for (const auto &engine: SolverRegistry::engines())
+            std::cerr << ' ' << engine.id;
+        std::cerr << " (default: propagation)\n";
+    }
+
+    /// Parse a positive count argument, 0 on error
+    std::size_t parseCount(const char *text) {
+        try {
+            const long long value = std::stoll(text);
+            return value > 0 ? static_cast<std::size_t>(value) : 0;
+        } catch (...) {
+            return 0;
+        }
+    }
+}
+
+/**
+ * @brief Headless batch solver entry point
+ * @param argc Argument count
+ * @param argv Argument values
+ * @return 0 on success, 1 if any puzzle was invalid, unsolvable or (with --unique) ambiguous, 2 on usage errors
+ * @details Puzzles are cut into chunks and solved on a work-stealing pool, each worker
+ *          with its own Sudoku instance. Finished chunks are written strictly in input
+ *          order; at most 4 chunks per worker are in flight, which bounds memory. The
+ *          chunk slots are reused, so once they have grown the run does not allocate.
+ */
+int main(int argc, char *argv[]) {
+    std::ios::sync_with_stdio(false);
+
+    EngineKind engine = EngineKind::Propagation;
+    bool timing = true;
+    bool unique = false;
+    bool rate = false;
+    std::size_t threads = 0;
+    std::size_t chunkSize = 64;
+    std::string path = "-";
+    std::string cachePath;
+
+    for (int i = 1; i < argc; ++i) {
+        const std::string_view arg = argv[i];
+        if (arg == "--engine" && i + 1 < argc) {
+            const auto *entry = SolverRegistry::find(argv[++i]);
+            if (entry == nullptr) {
+                std::cerr << "Unknown engine: " << argv[i] << '\n';
+                printUsage(argv[0]);
+                return 2;
+            }
+            engine = entry->kind;
+        } else if ((arg == "--threads" || arg == "--chunk") && i + 1 < argc) {
+            const std::size_t value = parseCount(argv[++i]);
+            if (value == 0) {
+                std::cerr << "Invalid value for " << arg << ": " << argv[i] << '\n';
+                return 2;
+            }
+            (arg == "--threads" ? threads : chunkSize) = value;
+        } else if (arg == "--unique") {
+            unique = true;
+        } else if (arg == "--rate") {
+            rate = true;
+        } else if (arg == "--cache" && i + 1 < argc) {
+            cachePath = argv[++i];
+        } else if (arg == "--no-timing") {
+            timing = false;
+        } else if (arg == "-h" || arg == "--help") {
+            printUsage(argv[0]);
+            return 0;
+        } else if (!arg.empty() && arg.front() == '-' && arg != "-") {
+            std::cerr << "Unknown option: " << arg << '\n';
+            printUsage(argv[0]);
+            return 2;
+        } else {
+            path = arg;
+        }
+    }
+
+    PuzzleCorpus corpus;
+    std::ifstream file;
+    if (path != "-" && PuzzleCorpus::isCorpus(path)) {
+        std::string error;
+        if (!corpus.open(path, &error)) {
+            std::cerr << error << '\n';
+            return 2;
+        }
+    } else if (path != "-") {
+        file.open(path);
+        if (!file) {
+            std::cerr << "Cannot open " << path << '\n';
+            return 2;
+        }
+    }
+    std::istream &in = (path == "-") ? std::cin : file;
+
+    ThreadPool pool(threads);
+    Settings settings{std::vector<WorkerContext>(pool.size()), timing, unique, rate,
+                      corpus.isOpen() ? &corpus : nullptr};
+    for (auto &ctx: settings.contexts) ctx.sudoku.setEngine(engine);
+
+    // One cache shared by all workers; a missing file starts empty
+    std::unique_ptr<SolutionCache> cache;
+    if (!cachePath.empty()) {
+        cache = std::make_unique<SolutionCache>();
+        cache->load(cachePath);
+        for (auto &ctx: settings.contexts) ctx.sudoku.setCache(cache.get());
+    }
+
+    // Reorder buffer: chunk n lives in slot n % window and is written before slot reuse
+    const std::size_t window = pool.size() * 4;
+    std::vector<Chunk> chunks(window);
+    for (auto &chunk: chunks) {
+        chunk.settings = &settings;
+        chunk.lines.resize(chunkSize);
+    }
+    std::size_t submitted = 0;
+    std::size_t written = 0;
+
+    std::size_t total = 0;
+    std::size_t solved = 0;
+    std::size_t failed = 0;
+    std::chrono::nanoseconds solveTime{0};
+    const auto wallStart = std::chrono::steady_clock::now();
+
+    const auto flushFront = [&] {
+        Chunk &front = chunks[written++ % window];
+        front.done.wait(false, std::memory_order_acquire);
+        std::cout << front.output;
+        solved += front.solved;
+        failed += front.failed;
+        solveTime += front.solveTime;
+    };
+    const auto dispatch = [&](Chunk &chunk) {
+        pool.submit([raw = &chunk] {
+            solveChunk(*raw, raw->settings->contexts[static_cast<std::size_t>(ThreadPool::currentWorker())]);
+            raw->done.store(true, std::memory_order_release);
+            raw->done.notify_one();
+        });
+        ++submitted;
+    };
+    // Next free slot, written out first if it still holds an earlier chunk
+    const auto acquire = [&]() -> Chunk & {
+        if (submitted - written == window) flushFront();
+        Chunk &chunk = chunks[submitted % window];
+        chunk.count = 0;
+        chunk.solved = 0;
+        chunk.failed = 0;
+        chunk.solveTime = {};
+        chunk.done.store(false, std::memory_order_relaxed);
+        return chunk;
+    };
+
+    if (corpus.isOpen()) {
+        // Records are decoded straight from the mapping by the workers
+        total = corpus.size();
+        for (std::size_t first = 0; first < total; first += chunkSize) {
+            Chunk &chunk = acquire();
+            chunk.first = first;
+            chunk.count = std::min(chunkSize, total - first);
+            dispatch(chunk);
+        }
+    } else {
+        std::string line;
+        Chunk *chunk = &acquire();
+        while (std::getline(in, line)) {
+            if (line.empty() || line.front() == '#') continue; // blank lines and comments
+            ++total;
+            chunk->lines[chunk->count++].assign(line);
+            if (chunk->count == chunkSize) {
+                dispatch(*chunk);
+                chunk = &acquire();
+            }
+        }
+        if (chunk->count > 0) dispatch(*chunk);
+    }
+    while (written < submitted) flushFront();
+    std::cout.flush();
+
+    // Summary goes to stderr so stdout stays machine-readable
+    const double wallSec = std::chrono::duration<double>(std::chrono::steady_clock::now() - wallStart).count();
+    const double solveSec = std::chrono::duration<double>(solveTime).count();
+    std::fprintf(stderr, "%zu puzzles, %zu solved, %zu failed | %zu threads | solve %.3f s, wall %.3f s, %.0f puzzles/s\n",
+                 total, solved, failed, pool.size(), solveSec, wallSec,
+                 wallSec > 0 ? static_cast<double>(total) / wallSec : 0.0);
+    if (cache) {
+        std::fprintf(stderr, "cache: %llu hits, %zu entries\n", static_cast<unsigned long long>(cache->hits()),
+                     cache->size());
+        if (!cache->save(cachePath)) {
+            std::cerr << "Cannot write " << cachePath << '\n';
+            return 2;
+        }
+    }
+    return failed == 0 ? 0 : 1;
+}
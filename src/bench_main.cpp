@@ -0,0 +1,432 @@
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <new>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+#include "CompactTrace.hpp"
+#include "ParallelSolver.hpp"
+#include "Sudoku.hpp"
+#include "ThreadPool.hpp"
+
+// ────────────────────────────────────────────────────────────────────────────────
+// Allocation counting hook (replaces the global operator new/delete)
+// ────────────────────────────────────────────────────────────────────────────────
+namespace {
+    std::atomic<std::uint64_t> allocCount{0}; ///< Calls to operator new (any thread)
+    std::atomic<std::uint64_t> allocBytes{0}; ///< Bytes requested from operator new
+
+    void *countedAlloc(std::size_t size, std::size_t align) {
+        allocCount.fetch_add(1, std::memory_order_relaxed);
+        allocBytes.fetch_add(size, std::memory_order_relaxed);
+        if (size == 0) size = 1;
+        void *p = align <= alignof(std::max_align_t)
+                      ? std::malloc(size)
+                      : std::aligned_alloc(align, (size + align - 1) / align * align);
+        if (p == nullptr) throw std::bad_alloc();
+        return p;
+    }
+}
+
+void *operator new(std::size_t size) { return countedAlloc(size, 0); }
+void *operator new[](std::size_t size) { return countedAlloc(size, 0); }
+void *operator new(std::size_t size, std::align_val_t align) { return countedAlloc(size, static_cast<std::size_t>(align)); }
+void *operator new[](std::size_t size, std::align_val_t align) { return countedAlloc(size, static_cast<std::size_t>(align)); }
+void operator delete(void *p) noexcept { std::free(p); }
+void operator delete[](void *p) noexcept { std::free(p); }
+void operator delete(void *p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void *p, std::size_t) noexcept { std::free(p); }
+void operator delete(void *p, std::align_val_t) noexcept { std::free(p); }
+void operator delete[](void *p, std::align_val_t) noexcept { std::free(p); }
+void operator delete(void *p, std::size_t, std::align_val_t) noexcept { std::free(p); }
+void operator delete[](void *p, std::size_t, std::align_val_t) noexcept { std::free(p); }
+
+namespace {
+    /**
+     * @enum Mode
+     * @brief Solver path exercised by a benchmark run
+     */
+    enum class Mode {
+        Solve, ///< Sudoku::solve()
+        Steps, ///< Sudoku::solveWithSteps() into a std::vector<SolveStep>
+        Trace, ///< Sudoku::solveWithSteps() into a CompactTrace (animation path)
+        Parallel ///< ParallelSolver::solve() on the thread pool
+    };
+
+    constexpr std::array<std::string_view, 4> MODE_NAMES = {"solve", "steps", "trace", "parallel"};
+
+    /**
+     * @struct Corpus
+     * @brief Named list of puzzles loaded from one file
+     */
+    struct Corpus {
+        std::string name; ///< File stem, e.g. "hard"
+        std::vector<SudokuBoard> puzzles; ///< Puzzles in file order
+    };
+
+    /**
+     * @struct Options
+     * @brief Command-line settings
+     */
+    struct Options {
+        std::vector<EngineKind> engines; ///< Engines to run (empty = all)
+        std::vector<Mode> modes; ///< Solver paths to run (empty = all)
+        std::size_t repeat{1}; ///< Measured passes over each corpus
+        std::size_t threads{0}; ///< Pool size for the parallel mode (0 = hardware threads)
+        double budget{5.0}; ///< Seconds per run before the current solve is cancelled
+        bool checkAllocs{false}; ///< Warm up on the whole corpus and fail runs that still allocate
+    };
+
+    /**
+     * @struct RunResult
+     * @brief Measurements of one (corpus, engine, mode) run
+     */
+    struct RunResult {
+        std::size_t puzzles{0}; ///< Solves measured
+        std::size_t solved{0}; ///< Solves that found a solution
+        bool truncated{false}; ///< Budget ran out before all passes finished (cancelled solve not counted)
+        bool warmupIncomplete{false}; ///< Warm-up budget ran out, so buffers may not have reached peak size
+        std::chrono::nanoseconds total{0}; ///< Sum of solve times
+        std::uint64_t nodes{0}; ///< Guesses placed, summed over all solves
+        std::uint64_t allocs{0}; ///< operator new calls during the solves
+        std::uint64_t bytes{0}; ///< Bytes requested during the solves
+        std::vector<std::chrono::nanoseconds> latencies; ///< Per-solve times
+    };
+
+    /**
+     * @brief Load a corpus file (same format as sudoku_batch input)
+     * @param path File with one 81-character puzzle per line, '#' comments
+     * @param corpus Filled with the file stem and the parsed puzzles
+     * @return false if the file cannot be read or has a malformed line
+     */
+    bool loadCorpus(const std::filesystem::path &path, Corpus &corpus) {
+        std::ifstream in(path);
+        if (!in) {
+            std::cerr << "Cannot open " << path.string() << '\n';
+            return false;
+        }
+        corpus.name = path.stem().string();
+        std::string line;
+        SudokuBoard board;
+        while (std::getline(in, line)) {
+            if (line.empty() || line.front() == '#') continue;
+            if (!SudokuBoard::parse(line, board)) {
+                std::cerr << path.string() << ": invalid puzzle " << line << '\n';
+                return false;
+            }
+            corpus.puzzles.push_back(board);
+        }
+        return true;
+    }
+
+    /**
+     * @brief Latency percentile (nearest rank)
+     * @param sorted Latencies in ascending order (not empty)
+     * @param percent Percentile in (0, 100]
+     * @return Latency in microseconds
+     */
+    double percentileUs(const std::vector<std::chrono::nanoseconds> &sorted, double percent) {
+        const auto rank = static_cast<std::size_t>(percent / 100.0 * static_cast<double>(sorted.size()) + 0.999999);
+        const std::size_t index = std::clamp<std::size_t>(rank, 1, sorted.size()) - 1;
+        return std::chrono::duration<double, std::micro>(sorted[index]).count();
+    }
+
+    /**
+     * @class Watchdog
+     * @brief Raises a cancellation flag once a time budget is spent
+     * @details Solvers poll the flag at every node, so even a single runaway
+     *          puzzle (naive engine on a 17-clue grid) cannot overrun the budget.
+     */
+    class Watchdog {
+        std::atomic<bool> expired_{false}; ///< Cancellation token handed to the solvers
+        std::mutex mutex_; ///< Protects the wait
+        std::condition_variable_any wake_; ///< Interrupted by the jthread stop request on destruction
+        std::jthread thread_; ///< Timer thread
+
+    public:
+        /// Start the timer
+        explicit Watchdog(std::chrono::duration<double> budget)
+            : thread_([this, budget](const std::stop_token &stop) {
+                std::unique_lock lock(mutex_);
+                wake_.wait_for(lock, stop, budget, [] { return false; });
+                if (!stop.stop_requested()) expired_.store(true, std::memory_order_relaxed);
+            }) {
+        }
+
+        /// Token to pass to setCancelToken()
+        [[nodiscard]] const std::atomic<bool> *token() const { return &expired_; }
+
+        /// Budget spent
+        [[nodiscard]] bool expired() const { return expired_.load(std::memory_order_relaxed); }
+    };
+
+    /**
+     * @brief Run one solver path over a corpus
+     * @param corpus Puzzles to solve
+     * @param engine Search algorithm
+     * @param mode Solver path
+     * @param pool Workers for Mode::Parallel
+     * @param options Repeat count and time budget
+     * @return Measurements; allocations are counted around each solve call only
+     * @details The first puzzle is solved once before measuring, so lazily created
+     *          engines and their fixed-size scratch buffers are not counted. With
+     *          --check-allocs the warm-up is a whole pass over the corpus, after which
+     *          step buffers and split scratch have reached their peak size and every
+     *          path should be allocation-free. The warm-up and the measured passes
+     *          each get the full budget; a warm-up cut short is flagged in the result,
+     *          since later solves may then still grow their buffers.
+     */
+    RunResult runBenchmark(const Corpus &corpus, EngineKind engine, Mode mode, ThreadPool &pool,
+                           const Options &options) {
+        Sudoku sudoku;
+        sudoku.setEngine(engine);
+        ParallelSolver parallel(pool, engine);
+        std::vector<SolveStep> steps;
+        CompactTrace trace;
+        SudokuBoard board;
+
+        const auto solveOne = [&](const SudokuBoard &puzzle, std::uint64_t &nodes) {
+            bool ok = false;
+            switch (mode) {
+                case Mode::Solve:
+                    sudoku.reset(puzzle);
+                    ok = sudoku.solve();
+                    nodes = sudoku.stats().nodes;
+                    break;
+                case Mode::Steps:
+                    sudoku.reset(puzzle);
+                    steps.clear();
+                    ok = sudoku.solveWithSteps(steps);
+                    nodes = sudoku.stats().nodes;
+                    break;
+                case Mode::Trace:
+                    sudoku.reset(puzzle);
+                    trace.clear();
+                    ok = sudoku.solveWithSteps(trace);
+                    nodes = sudoku.stats().nodes;
+                    break;
+                case Mode::Parallel:
+                    board = puzzle;
+                    ok = parallel.solve(board);
+                    nodes = parallel.stats().nodes;
+                    break;
+            }
+            return ok;
+        };
+
+        RunResult result;
+        if (corpus.puzzles.empty()) return result;
+
+        const std::size_t planned = corpus.puzzles.size() * options.repeat;
+        result.latencies.reserve(planned);
+
+        std::uint64_t nodes = 0;
+        {
+            const Watchdog warmupWatchdog{std::chrono::duration<double>(options.budget)};
+            sudoku.setCancelToken(warmupWatchdog.token());
+            parallel.setCancelToken(warmupWatchdog.token());
+            const std::size_t warmup = options.checkAllocs ? corpus.puzzles.size() : 1;
+            for (std::size_t i = 0; i < warmup && !warmupWatchdog.expired(); ++i)
+                solveOne(corpus.puzzles[i], nodes);
+            result.warmupIncomplete = warmupWatchdog.expired();
+        }
+
+        const Watchdog watchdog{std::chrono::duration<double>(options.budget)};
+        sudoku.setCancelToken(watchdog.token());
+        parallel.setCancelToken(watchdog.token());
+
+        for (std::size_t i = 0; i < planned; ++i) {
+            const SudokuBoard &puzzle = corpus.puzzles[i % corpus.puzzles.size()];
+
+            const std::uint64_t allocsBefore = allocCount.load(std::memory_order_relaxed);
+            const std::uint64_t bytesBefore = allocBytes.load(std::memory_order_relaxed);
+            const auto start = std::chrono::steady_clock::now();
+            const bool ok = solveOne(puzzle, nodes);
+            const auto elapsed = std::chrono::steady_clock::now() - start;
+            result.allocs += allocCount.load(std::memory_order_relaxed) - allocsBefore;
+            result.bytes += allocBytes.load(std::memory_order_relaxed) - bytesBefore;
+            if (watchdog.expired()) break;
+
+            ++result.puzzles;
+            result.solved += ok ? 1 : 0;
+            result.nodes += nodes;
+            result.total += elapsed;
+            result.latencies.push_back(elapsed);
+        }
+        result.truncated = result.puzzles < planned;
+        return result;
+    }
+
+    /**
+     * @brief Print one run as a JSON object on a single line
+     * @details Keys are stable across releases so runs can be diffed by tools
+     */
+    void printResult(const Corpus &corpus, EngineKind engine, Mode mode, RunResult &result) {
+        std::sort(result.latencies.begin(), result.latencies.end());
+        const double seconds = std::chrono::duration<double>(result.total).count();
+        const double solves = result.puzzles > 0 ? static_cast<double>(result.puzzles) : 1.0;
+        const bool any = !result.latencies.empty();
+        std::printf("{\"corpus\":\"%s\",\"engine\":\"%.*s\",\"mode\":\"%.*s\",\"puzzles\":%zu,\"solved\":%zu,"
+                    "\"truncated\":%s,\"seconds\":%.6f,\"puzzles_per_s\":%.1f,\"nodes\":%llu,\"nodes_per_s\":%.0f,"
+                    "\"p50_us\":%.2f,\"p99_us\":%.2f,\"allocs_per_solve\":%.2f,\"bytes_per_solve\":%.0f}\n",
+                    corpus.name.c_str(),
+                    static_cast<int>(SolverRegistry::entry(engine).id.size()), SolverRegistry::entry(engine).id.data(),
+                    static_cast<int>(MODE_NAMES[static_cast<std::size_t>(mode)].size()),
+                    MODE_NAMES[static_cast<std::size_t>(mode)].data(),
+                    result.puzzles, result.solved, result.truncated ? "true" : "false", seconds,
+                    seconds > 0 ? static_cast<double>(result.puzzles) / seconds : 0.0,
+                    static_cast<unsigned long long>(result.nodes),
+                    seconds > 0 ? static_cast<double>(result.nodes) / seconds : 0.0,
+                    any ? percentileUs(result.latencies, 50) : 0.0, any ? percentileUs(result.latencies, 99) : 0.0,
+                    static_cast<double>(result.allocs) / solves, static_cast<double>(result.bytes) / solves);
+        std::fflush(stdout);
+    }
+
+    /// Print command-line help
+    void printUsage(const char *program) {
+        std::cerr << "Usage: " << program
+                  << " [--engine ID]... [--mode M]... [--repeat N] [--budget S] [--threads N] [--check-allocs] [FILE...]\n"
+                  << "  Solves every corpus FILE (default: the bundled easy, hard and 17-clue corpora)\n"
+                  << "  with every engine and solver path, and prints one JSON object per run to stdout:\n"
+                  << "    corpus, engine, mode, puzzles, solved, truncated, seconds, puzzles_per_s,\n"
+                  << "    nodes, nodes_per_s, p50_us, p99_us, allocs_per_solve, bytes_per_solve\n"
+                  << "  --engine ID  run only this engine (repeatable)\n"
+                  << "  --mode M     run only this path: solve, steps, trace, parallel (repeatable)\n"
+                  << "  --repeat N   measured passes over each corpus (default: 1)\n"
+                  << "  --budget S   seconds per run (and per warm-up); the solve in progress is\n"
+                  << "               cancelled, the remaining puzzles are skipped and the run is\n"
+                  << "               marked truncated (default: 5)\n"
+                  << "  --threads N  workers for the parallel mode (default: all hardware threads)\n"
+                  << "  --check-allocs  warm up on the whole corpus, then fail (exit 1) if any\n"
+                  << "               measured solve calls operator new or a run measured nothing;\n"
+                  << "               runs whose warm-up ran out of budget are reported as\n"
+                  << "               \"warm-up incomplete\" and not checked for allocations\n"
+                  << "  Engines:";
+        for (const auto &engine: SolverRegistry::engines())
+            std::cerr << ' ' << engine.id;
+        std::cerr << '\n';
+    }
+
+    /// Parse a positive count argument, 0 on error
+    std::size_t parseCount(const char *text) {
+        try {
+            const long long value = std::stoll(text);
+            return value > 0 ? static_cast<std::size_t>(value) : 0;
+        } catch (...) {
+            return 0;
+        }
+    }
+}
+
+/**
+ * @brief Benchmark entry point
+ * @param argc Argument count
+ * @param argv Argument values
+ * @return 0 on success, 1 if a puzzle was not solved (or, with --check-allocs, a
+ *         warmed-up run allocated or measured no solves), 2 on usage or input errors
+ * @details Runs are sequential: one (corpus, engine, mode) at a time, timed per
+ *          puzzle with steady_clock. Human-readable progress goes to stderr.
+ */
+int main(int argc, char *argv[]) {
+    Options options;
+    std::vector<std::filesystem::path> files;
+
+    for (int i = 1; i < argc; ++i) {
+        const std::string_view arg = argv[i];
+        if (arg == "--engine" && i + 1 < argc) {
+            const auto *entry = SolverRegistry::find(argv[++i]);
+            if (entry == nullptr) {
+                std::cerr << "Unknown engine: " << argv[i] << '\n';
+                printUsage(argv[0]);
+                return 2;
+            }
+            options.engines.push_back(entry->kind);
+        } else if (arg == "--mode" && i + 1 < argc) {
+            const auto it = std::find(MODE_NAMES.begin(), MODE_NAMES.end(), std::string_view(argv[++i]));
+            if (it == MODE_NAMES.end()) {
+                std::cerr << "Unknown mode: " << argv[i] << '\n';
+                printUsage(argv[0]);
+                return 2;
+            }
+            options.modes.push_back(static_cast<Mode>(it - MODE_NAMES.begin()));
+        } else if ((arg == "--repeat" || arg == "--threads") && i + 1 < argc) {
+            const std::size_t value = parseCount(argv[++i]);
+            if (value == 0) {
+                std::cerr << "Invalid value for " << arg << ": " << argv[i] << '\n';
+                return 2;
+            }
+            (arg == "--repeat" ? options.repeat : options.threads) = value;
+        } else if (arg == "--budget" && i + 1 < argc) {
+            options.budget = std::atof(argv[++i]);
+            if (options.budget <= 0) {
+                std::cerr << "Invalid value for --budget: " << argv[i] << '\n';
+                return 2;
+            }
+        } else if (arg == "--check-allocs") {
+            options.checkAllocs = true;
+        } else if (arg == "-h" || arg == "--help") {
+            printUsage(argv[0]);
+            return 0;
+        } else if (!arg.empty() && arg.front() == '-') {
+            std::cerr << "Unknown option: " << arg << '\n';
+            printUsage(argv[0]);
+            return 2;
+        } else {
+            files.emplace_back(arg);
+        }
+    }
+
+    if (files.empty()) {
+        const std::filesystem::path dir = SUDOKU_CORPUS_DIR;
+        files = {dir / "easy.txt", dir / "hard.txt", dir / "17clue.txt"};
+    }
+    if (options.engines.empty())
+        for (const auto &entry: SolverRegistry::engines()) options.engines.push_back(entry.kind);
+    if (options.modes.empty())
+        options.modes = {Mode::Solve, Mode::Steps, Mode::Trace, Mode::Parallel};
+
+    std::vector<Corpus> corpora(files.size());
+    for (std::size_t i = 0; i < files.size(); ++i)
+        if (!loadCorpus(files[i], corpora[i])) return 2;
+
+    ThreadPool pool(options.threads);
+    bool allSolved = true;
+    bool allocFree = true;
+    for (const auto &corpus: corpora) {
+        for (const EngineKind engine: options.engines) {
+            for (const Mode mode: options.modes) {
+                RunResult result = runBenchmark(corpus, engine, mode, pool, options);
+                allSolved = allSolved && result.solved == result.puzzles;
+                // After a truncated warm-up, allocations are buffers still growing, not a leak
+                const bool warmedUp = options.checkAllocs && !result.warmupIncomplete;
+                const bool leaked = warmedUp && result.allocs > 0;
+                // A run cut off before its first measured solve proves nothing about allocations
+                const bool unmeasured = options.checkAllocs && result.puzzles == 0;
+                allocFree = allocFree && !leaked && !unmeasured;
+                std::fprintf(stderr, "%-8s %-12.*s %-8.*s %zu/%zu%s%s%s%s\n", corpus.name.c_str(),
+                             static_cast<int>(SolverRegistry::entry(engine).id.size()),
+                             SolverRegistry::entry(engine).id.data(),
+                             static_cast<int>(MODE_NAMES[static_cast<std::size_t>(mode)].size()),
+                             MODE_NAMES[static_cast<std::size_t>(mode)].data(), result.solved, result.puzzles,
+                             result.truncated ? " (budget exhausted)" : "",
+                             options.checkAllocs && result.warmupIncomplete ? " (warm-up incomplete)" : "",
+                             leaked ? " (allocates after warm-up)" : "",
+                             unmeasured ? " (nothing measured)" : "");
+                printResult(corpus, engine, mode, result);
+            }
+        }
+    }
+    return allSolved && allocFree ? 0 : 1;
+}
@@ -0,0 +1,236 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <latch>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "DifficultyRater.hpp"
+#include "PuzzleCorpus.hpp"
+#include "Sudoku.hpp"
+#include "ThreadPool.hpp"
+
+namespace {
+    constexpr std::size_t ROUND = 65536; ///< Puzzles read, checked and written together
+    constexpr std::size_t BLOCK = 1024; ///< Puzzles per pool task
+
+    /**
+     * @struct Entry
+     * @brief One parsed input puzzle and its verdict
+     */
+    struct Entry {
+        SudokuBoard puzzle; ///< Parsed puzzle
+        bool keep{true}; ///< Passed the requested checks
+        std::optional<Difficulty> difficulty; ///< Rating (--rate)
+    };
+
+    /// Print command-line help
+    void printUsage(const char *program) {
+        std::cerr << "Usage: " << program << " [--unique] [--rate] [--threads N] INPUT OUTPUT\n"
+                  << "       " << program << " --info FILE\n"
+                  << "       " << program << " --text FILE\n"
+                  << "  Converts puzzles in the 81-character text format (INPUT, '-' = stdin)\n"
+                  << "  into a binary corpus: 41-byte records, memory-mapped by readers.\n"
+                  << "  --unique     keep only puzzles with exactly one solution (sets the unique flag)\n"
+                  << "  --rate       grade every puzzle and write the difficulty bucket index\n"
+                  << "  --threads N  worker threads for --unique/--rate (default: all hardware threads)\n"
+                  << "  --info FILE  print the header of a corpus\n"
+                  << "  --text FILE  write the puzzles of a corpus to stdout as text\n";
+    }
+
+    /// Parse a positive count argument, 0 on error
+    std::size_t parseCount(const char *text) {
+        try {
+            const long long value = std::stoll(text);
+            return value > 0 ? static_cast<std::size_t>(value) : 0;
+        } catch (...) {
+            return 0;
+        }
+    }
+
+    /// Run unique/rate checks over a round in blocks on the pool
+    void check(ThreadPool &pool, std::vector<Entry> &entries, const std::size_t count, const bool unique,
+               const bool rate) {
+        const std::size_t blocks = (count + BLOCK - 1) / BLOCK;
+        std::latch done(static_cast<std::ptrdiff_t>(blocks));
+        for (std::size_t block = 0; block < blocks; ++block) {
+            pool.submit([&, block] {
+                Sudoku sudoku;
+                DifficultyRater rater;
+                const std::size_t end = std::min(count, (block + 1) * BLOCK);
+                for (std::size_t i = block * BLOCK; i < end; ++i) {
+                    Entry &entry = entries[i];
+                    if (unique) {
+                        sudoku.reset(entry.puzzle);
+                        entry.keep = sudoku.hasUniqueSolution();
+                    }
+                    if (rate && entry.keep) {
+                        const Rating rating = rater.rate(entry.puzzle);
+                        entry.keep = rating.valid;
+                        entry.difficulty = rating.difficulty;
+                    }
+                }
+                done.count_down();
+            });
+        }
+        done.wait();
+    }
+
+    /// --info: header summary
+    int printInfo(const std::string &path) {
+        PuzzleCorpus corpus;
+        std::string error;
+        if (!corpus.open(path, &error)) {
+            std::cerr << error << '\n';
+            return 2;
+        }
+        std::cout << path << ": " << corpus.size() << " puzzles, format v" << corpus.header().version
+                  << (corpus.unique() ? ", unique" : ", uniqueness not checked")
+                  << (corpus.rated() ? ", rated" : ", unrated") << '\n';
+        if (corpus.rated()) {
+            for (std::size_t i = 0; i < DIFFICULTY_COUNT; ++i) {
+                const auto level = static_cast<Difficulty>(i);
+                std::cout << "  " << DifficultyRater::name(level) << ": " << corpus.bucketSize(level) << '\n';
+            }
+        }
+        return 0;
+    }
+
+    /// --text: corpus back to 81-character lines
+    int printText(const std::string &path) {
+        PuzzleCorpus corpus;
+        std::string error;
+        if (!corpus.open(path, &error)) {
+            std::cerr << error << '\n';
+            return 2;
+        }
+        std::string text;
+        std::size_t damaged = 0;
+        for (std::size_t i = 0; i < corpus.size(); ++i) {
+            if (!corpus.valid(i)) {
+                ++damaged;
+                continue;
+            }
+            corpus.at(i).appendTo(text);
+            text += '\n';
+            if (text.size() >= (1U << 20)) {
+                std::cout << text;
+                text.clear();
+            }
+        }
+        std::cout << text;
+        if (damaged > 0) {
+            std::cerr << path << ": skipped " << damaged << " damaged records\n";
+            return 1;
+        }
+        return 0;
+    }
+}
+
+/**
+ * @brief Corpus converter entry point
+ * @param argc Argument count
+ * @param argv Argument values
+ * @return 0 on success, 1 if writing failed (or --text met damaged records), 2 on usage or input errors
+ * @details Text is read in rounds of ROUND puzzles; the optional checks run on a
+ *          thread pool and records are written in input order. Malformed lines, and
+ *          with --unique puzzles without exactly one solution, are skipped.
+ */
+int main(int argc, char *argv[]) {
+    std::ios::sync_with_stdio(false);
+
+    bool unique = false;
+    bool rate = false;
+    std::size_t threads = 0;
+    std::vector<std::string> paths;
+
+    for (int i = 1; i < argc; ++i) {
+        const std::string_view arg = argv[i];
+        if (arg == "--unique") {
+            unique = true;
+        } else if (arg == "--rate") {
+            rate = true;
+        } else if (arg == "--threads" && i + 1 < argc) {
+            threads = parseCount(argv[++i]);
+            if (threads == 0) {
+                std::cerr << "Invalid value for --threads: " << argv[i] << '\n';
+                return 2;
+            }
+        } else if ((arg == "--info" || arg == "--text") && i + 1 < argc) {
+            return arg == "--info" ? printInfo(argv[i + 1]) : printText(argv[i + 1]);
+        } else if (arg == "-h" || arg == "--help") {
+            printUsage(argv[0]);
+            return 0;
+        } else if (!arg.empty() && arg.front() == '-' && arg != "-") {
+            std::cerr << "Unknown option: " << arg << '\n';
+            printUsage(argv[0]);
+            return 2;
+        } else {
+            paths.emplace_back(arg);
+        }
+    }
+    if (paths.size() != 2) {
+        printUsage(argv[0]);
+        return 2;
+    }
+
+    std::ifstream file;
+    if (paths[0] != "-") {
+        file.open(paths[0]);
+        if (!file) {
+            std::cerr << "Cannot open " << paths[0] << '\n';
+            return 2;
+        }
+    }
+    std::istream &in = (paths[0] == "-") ? std::cin : file;
+
+    CorpusWriter writer;
+    if (!writer.open(paths[1])) {
+        std::cerr << "Cannot create " << paths[1] << '\n';
+        return 2;
+    }
+
+    ThreadPool pool(unique || rate ? threads : 1);
+    const auto start = std::chrono::steady_clock::now();
+    std::vector<Entry> entries(ROUND);
+    std::size_t read = 0;
+    std::size_t skipped = 0;
+    std::string line;
+    for (bool more = true; more;) {
+        std::size_t count = 0;
+        while (count < ROUND && (more = static_cast<bool>(std::getline(in, line)))) {
+            if (line.empty() || line.front() == '#') continue; // blank lines and comments
+            ++read;
+            Entry &entry = entries[count];
+            if (!SudokuBoard::parse(line, entry.puzzle)) {
+                ++skipped;
+                continue;
+            }
+            entry.keep = true;
+            entry.difficulty.reset();
+            ++count;
+        }
+        if (unique || rate) check(pool, entries, count, unique, rate);
+        for (std::size_t i = 0; i < count; ++i) {
+            if (entries[i].keep)
+                writer.add(entries[i].puzzle, entries[i].difficulty);
+            else
+                ++skipped;
+        }
+    }
+
+    const std::uint64_t written = writer.count();
+    if (!writer.finish(unique)) {
+        std::cerr << "Writing " << paths[1] << " failed\n";
+        return 1;
+    }
+
+    // Summary goes to stderr like the other tools
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::fprintf(stderr, "%zu puzzles read, %llu written, %zu skipped | %zu threads | %.3f s\n", read,
+                 static_cast<unsigned long long>(written), skipped, pool.size(), seconds);
+    return 0;
+}
@@ -0,0 +1,130 @@
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <iostream>
+#include <optional>
+#include <random>
+#include <string>
+#include <string_view>
+#include "PuzzleGenerator.hpp"
+
+namespace {
+    constexpr std::size_t ROUND = 4096; ///< Puzzles generated between two writes
+
+    /// Print command-line help
+    void printUsage(const char *program) {
+        std::cerr << "Usage: " << program << " [--count N] [--clues N | --difficulty LEVEL] [--seed S] [--threads N]\n"
+                  << "  Writes N random puzzles with a unique solution to stdout, one\n"
+                  << "  81-character line each ('.' = empty), ready for sudoku_batch.\n"
+                  << "  --count N    puzzles to generate (default: 1000)\n"
+                  << "  --clues N    target clue count, " << PuzzleGenerator::MIN_CLUES << "-81 (default: "
+                  << PuzzleGenerator::DEFAULT_CLUES << ");\n"
+                  << "               puzzles that turn minimal first keep more clues\n"
+                  << "  --difficulty LEVEL  easy, medium, hard, expert or extreme: only puzzles\n"
+                  << "               the DifficultyRater puts in that bucket (overrides --clues)\n"
+                  << "  --seed S     seed for reproducible output (default: random)\n"
+                  << "  --threads N  worker threads (default: all hardware threads)\n";
+    }
+
+    /// Parse a difficulty name (case-insensitive), nullopt on error
+    std::optional<Difficulty> parseDifficulty(const std::string_view text) {
+        for (std::size_t i = 0; i < DIFFICULTY_COUNT; ++i) {
+            const auto level = static_cast<Difficulty>(i);
+            const std::string_view name = DifficultyRater::name(level);
+            if (std::ranges::equal(text, name, [](const char a, const char b) {
+                    return std::tolower(static_cast<unsigned char>(a)) == std::tolower(static_cast<unsigned char>(b));
+                }))
+                return level;
+        }
+        return std::nullopt;
+    }
+
+    /// Parse a positive count argument, 0 on error
+    std::size_t parseCount(const char *text) {
+        try {
+            const long long value = std::stoll(text);
+            return value > 0 ? static_cast<std::size_t>(value) : 0;
+        } catch (...) {
+            return 0;
+        }
+    }
+}
+
+/**
+ * @brief Bulk puzzle generator entry point
+ * @param argc Argument count
+ * @param argv Argument values
+ * @return 0 on success, 2 on usage errors
+ * @details Puzzles are generated in rounds of ROUND on a thread pool and written
+ *          in order; equal seeds give equal output whatever the thread count.
+ */
+int main(int argc, char *argv[]) {
+    std::ios::sync_with_stdio(false);
+
+    std::size_t count = 1000;
+    std::size_t clues = PuzzleGenerator::DEFAULT_CLUES;
+    std::size_t threads = 0;
+    std::optional<Difficulty> difficulty;
+    std::uint64_t seed = std::random_device{}();
+
+    for (int i = 1; i < argc; ++i) {
+        const std::string_view arg = argv[i];
+        if ((arg == "--count" || arg == "--clues" || arg == "--threads") && i + 1 < argc) {
+            const std::size_t value = parseCount(argv[++i]);
+            if (value == 0 || (arg == "--clues" && (value < PuzzleGenerator::MIN_CLUES || value > 81))) {
+                std::cerr << "Invalid value for " << arg << ": " << argv[i] << '\n';
+                return 2;
+            }
+            (arg == "--count" ? count : arg == "--clues" ? clues : threads) = value;
+        } else if (arg == "--difficulty" && i + 1 < argc) {
+            difficulty = parseDifficulty(argv[++i]);
+            if (!difficulty) {
+                std::cerr << "Invalid value for --difficulty: " << argv[i] << '\n';
+                return 2;
+            }
+        } else if (arg == "--seed" && i + 1 < argc) {
+            try {
+                seed = std::stoull(argv[++i]);
+            } catch (...) {
+                std::cerr << "Invalid value for --seed: " << argv[i] << '\n';
+                return 2;
+            }
+        } else if (arg == "-h" || arg == "--help") {
+            printUsage(argv[0]);
+            return 0;
+        } else {
+            std::cerr << "Unknown option: " << arg << '\n';
+            printUsage(argv[0]);
+            return 2;
+        }
+    }
+
+    ThreadPool pool(threads);
+    const auto start = std::chrono::steady_clock::now();
+    std::size_t totalClues = 0;
+    std::string text;
+    for (std::size_t done = 0, round = 0; done < count; ++round) {
+        const std::size_t n = std::min(ROUND, count - done);
+        const std::uint64_t roundSeed = PuzzleGenerator::streamSeed(seed, round);
+        const auto puzzles = difficulty ? PuzzleGenerator::generateMany(pool, n, *difficulty, roundSeed)
+                                        : PuzzleGenerator::generateMany(pool, n, static_cast<int>(clues), roundSeed);
+        text.clear();
+        for (const auto &puzzle: puzzles) {
+            puzzle.appendTo(text);
+            text += '\n';
+            totalClues += static_cast<std::size_t>(std::ranges::count_if(puzzle.cells, [](auto v) { return v != 0; }));
+        }
+        std::cout << text;
+        done += n;
+    }
+    std::cout.flush();
+
+    // Summary goes to stderr so stdout stays machine-readable
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::fprintf(stderr, "%zu puzzles, %.1f clues on average | %zu threads | %.3f s, %.0f puzzles/s\n", count,
+                 static_cast<double>(totalClues) / static_cast<double>(count), pool.size(), seconds,
+                 seconds > 0 ? static_cast<double>(count) / seconds : 0.0);
+    return 0;
+}
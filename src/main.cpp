@@ -1,4 +1,5 @@
 #include <QApplication>
+#include <QCommandLineParser>
 #include "MainWindow.hpp"
 
 /**
@@ -7,14 +8,30 @@
  * @param argv Argument values
  * @return Application exit code
  *
- * Initializes Qt application with Sudoku Solver window and starts event loop
+ * Initializes Qt application with Sudoku Solver window and starts event loop.
+ * `--corpus FILE` makes New Puzzle draw from a binary corpus (see sudoku_corpus);
+ * `--puzzle FILE` starts with the puzzle of a text file, of any supported size.
  */
 int main(int argc, char *argv[]) {
     QApplication app(argc, argv);
     app.setApplicationName("Sudoku Solver");
     app.setApplicationVersion("2.0");
 
+    QCommandLineParser parser;
+    parser.addHelpOption();
+    parser.addVersionOption();
+    const QCommandLineOption corpusOption("corpus", "Draw new puzzles from a binary puzzle corpus.", "file");
+    parser.addOption(corpusOption);
+    const QCommandLineOption puzzleOption("puzzle", "Start with a one-line puzzle (4x4 to 25x25) from a text file.",
+                                          "file");
+    parser.addOption(puzzleOption);
+    parser.process(app);
+
     MainWindow window;
+    if (parser.isSet(corpusOption))
+        window.openCorpus(parser.value(corpusOption));
+    if (parser.isSet(puzzleOption))
+        window.openPuzzle(parser.value(puzzleOption));
     window.show();
 
     return app.exec();
@@ -0,0 +1,172 @@
+#include <gtest/gtest.h>
+#include <cctype>
+#include <string>
+#include <type_traits>
+#include <vector>
+#include "BacktrackingEngines.hpp"
+#include "CompactTrace.hpp"
+#include "TracePlayer.hpp"
+
+namespace
+{
+    /// Valid solved grid: the classic shifted-row pattern
+    template<int Box>
+    BasicBoard<Box> patternGrid()
+    {
+        using Board = BasicBoard<Box>;
+        Board board;
+        for (int r = 0; r < Board::SIZE; ++r)
+            for (int c = 0; c < Board::SIZE; ++c)
+                board.set(r, c, (Box * (r % Box) + r / Box + c) % Board::SIZE + 1);
+        return board;
+    }
+
+    /// Puzzle from a solved grid: every cell whose index is not a multiple of keep is cleared
+    template<int Box>
+    BasicBoard<Box> punch(const BasicBoard<Box> &solution, const int keep)
+    {
+        BasicBoard<Box> puzzle = solution;
+        for (int i = 0; i < BasicBoard<Box>::CELLS; ++i)
+            if (i % keep != 0)
+                puzzle.cells[static_cast<size_t>(i)] = 0;
+        return puzzle;
+    }
+
+    /// Every row, column and box holds each digit exactly once
+    template<int Box>
+    bool isSolved(const BasicBoard<Box> &board)
+    {
+        using Board = BasicBoard<Box>;
+        for (int i = 0; i < Board::SIZE; ++i)
+        {
+            std::uint64_t row = 0;
+            std::uint64_t col = 0;
+            std::uint64_t box = 0;
+            for (int j = 0; j < Board::SIZE; ++j)
+            {
+                row |= std::uint64_t{1} << board.get(i, j);
+                col |= std::uint64_t{1} << board.get(j, i);
+                box |= std::uint64_t{1} << board.get(i / Box * Box + j / Box, i % Box * Box + j % Box);
+            }
+            const std::uint64_t all = ((std::uint64_t{1} << Board::SIZE) - 1) << 1;
+            if (row != all || col != all || box != all)
+                return false;
+        }
+        return true;
+    }
+}
+
+/// Test: Geometry, mask widths and the one-line format follow the box size
+TEST(BoardSizesTest, GeometryAndTextFormat)
+{
+    static_assert(BasicBoard<2>::CELLS == 16 && BasicBoard<4>::CELLS == 256 && BasicBoard<5>::SIZE == 25);
+    static_assert(std::is_same_v<BasicBoard<2>::Mask, std::uint8_t>);
+    static_assert(std::is_same_v<BasicBoard<4>::Mask, std::uint16_t>);
+    static_assert(std::is_same_v<BasicBoard<5>::Mask, std::uint32_t>);
+    static_assert(std::is_same_v<BasicBoard<5>::Index, std::uint16_t>);
+    EXPECT_EQ(boxSizeForCells(16), 2);
+    EXPECT_EQ(boxSizeForCells(81), 3);
+    EXPECT_EQ(boxSizeForCells(625), 5);
+    EXPECT_EQ(boxSizeForCells(100), 0);
+
+    const auto solution = patternGrid<5>();
+    const std::string text = solution.toString();
+    ASSERT_EQ(text.size(), 625u);
+    EXPECT_EQ(text.substr(0, 25), "123456789ABCDEFGHIJKLMNOP");
+
+    BasicBoard<5> parsed;
+    ASSERT_TRUE(BasicBoard<5>::parse(text, parsed));
+    EXPECT_EQ(parsed, solution);
+    std::string lower = text;
+    for (char &ch : lower)
+        ch = static_cast<char>(std::tolower(static_cast<unsigned char>(ch)));
+    ASSERT_TRUE(BasicBoard<5>::parse(lower, parsed));
+    EXPECT_EQ(parsed, solution);
+
+    // Digits above the board size are rejected
+    BasicBoard<4> small;
+    EXPECT_TRUE(BasicBoard<4>::parse(std::string(255, '.') + "G", small));
+    EXPECT_FALSE(BasicBoard<4>::parse(std::string(255, '.') + "H", small));
+    BasicBoard<2> tiny;
+    EXPECT_FALSE(BasicBoard<2>::parse("1234.........5..", tiny));
+}
+
+/// Test: Every engine solves 4x4 and 16x16 puzzles; Dlx falls back to propagation off 9x9
+TEST(BoardSizesTest, EnginesSolveEverySize)
+{
+    const auto small = patternGrid<2>();
+    const auto large = patternGrid<4>();
+    for (const auto &entry : SolverRegistry::engines())
+    {
+        const auto engine4 = SolverRegistry::create<2>(entry.kind);
+        auto board4 = punch(small, 3);
+        ASSERT_TRUE(engine4->solve(board4, nullptr)) << entry.id;
+        EXPECT_TRUE(isSolved(board4)) << entry.id;
+
+        const auto engine16 = SolverRegistry::create<4>(entry.kind);
+        auto board16 = punch(large, entry.kind == EngineKind::Naive ? 2 : 4);
+        ASSERT_TRUE(engine16->solve(board16, nullptr)) << entry.id;
+        EXPECT_TRUE(isSolved(board16)) << entry.id;
+        for (int i = 0; i < BasicBoard<4>::CELLS; i += 4)
+            EXPECT_EQ(board16.cells[static_cast<size_t>(i)], large.cells[static_cast<size_t>(i)]);
+
+        EXPECT_EQ(engine16->kind(), entry.kind == EngineKind::Dlx ? EngineKind::Propagation : entry.kind);
+    }
+    EXPECT_EQ(SolverRegistry::create<3>(EngineKind::Dlx)->kind(), EngineKind::Dlx);
+
+    // There are 288 4x4 grids; conflicting givens have no solution
+    EXPECT_EQ(SolverRegistry::create<2>(EngineKind::Mrv)->countSolutions(BasicBoard<2>{}, 1000), 288u);
+    BasicBoard<2> conflict;
+    conflict.set(0, 0, 1);
+    conflict.set(1, 1, 1);
+    EXPECT_EQ(SolverRegistry::create<2>(EngineKind::Propagation)->countSolutions(conflict, 2), 0u);
+}
+
+/// Test: A 25x25 solve recorded as 32-bit codes replays to the solution
+TEST(BoardSizesTest, TraceRoundTrip25x25)
+{
+    using Trace = BasicCompactTrace<5>;
+    static_assert(sizeof(Trace::Code) == 4);
+    const SolveStep last{24, 24, 25, StepKind::Deduced};
+    const SolveStep decoded = Trace::decode(Trace::encode(last));
+    EXPECT_EQ(decoded.row, 24);
+    EXPECT_EQ(decoded.col, 24);
+    EXPECT_EQ(decoded.value, 25);
+    EXPECT_EQ(decoded.kind, StepKind::Deduced);
+
+    const auto solution = patternGrid<5>();
+    const auto puzzle = punch(solution, 2);
+    BasicPropagationEngine<5> engine;
+    std::vector<SolveStep> steps;
+    VectorStepSink sink(steps);
+    auto board = puzzle;
+    ASSERT_TRUE(engine.solve(board, &sink));
+    EXPECT_TRUE(isSolved(board));
+    ASSERT_FALSE(steps.empty());
+
+    Trace trace;
+    BasicTracePlayer<5> player(64);
+    player.reset(puzzle);
+    for (const auto &step : steps)
+    {
+        trace.push(step);
+        player.append(step);
+    }
+    ASSERT_EQ(trace.size(), steps.size());
+    size_t i = 0;
+    for (const SolveStep step : trace)
+    {
+        ASSERT_EQ(step.row, steps[i].row) << i;
+        ASSERT_EQ(step.col, steps[i].col) << i;
+        ASSERT_EQ(step.value, steps[i].value) << i;
+        ASSERT_EQ(step.kind, steps[i].kind) << i;
+        ++i;
+    }
+
+    player.seek(steps.size());
+    EXPECT_EQ(player.frame().board, board);
+    player.seek(steps.size() / 2);
+    BasicTracePlayer<5>::Cells touched;
+    EXPECT_EQ(player.advance(steps.size(), touched), steps.size() - steps.size() / 2);
+    EXPECT_EQ(player.frame().board, board);
+}
@@ -0,0 +1,54 @@
+#include <gtest/gtest.h>
+#include <vector>
+#include "CompactTrace.hpp"
+#include "Sudoku.hpp"
+
+/// Test: Every cell/value/kind combination survives encoding
+TEST(CompactTraceTest, EncodeDecodeRoundTrip)
+{
+    for (int cell = 0; cell < 81; ++cell)
+        for (int value = 0; value <= 9; ++value)
+            for (const StepKind kind : {StepKind::Guess, StepKind::Deduced})
+            {
+                const SolveStep step{cell / 9, cell % 9, value, kind};
+                const SolveStep back = CompactTrace::decode(CompactTrace::encode(step));
+                EXPECT_EQ(back.row, step.row);
+                EXPECT_EQ(back.col, step.col);
+                EXPECT_EQ(back.value, step.value);
+                EXPECT_EQ(back.kind, step.kind);
+            }
+}
+
+/// Test: Compact traces replay the exact step sequence, with and without bounce coalescing
+TEST(CompactTraceTest, MatchesVectorTrace)
+{
+    for (const EngineKind engine : {EngineKind::Bitmask, EngineKind::Propagation, EngineKind::Dlx})
+    {
+        Sudoku recorder(Sudoku::DEFAULT_BOARD);
+        recorder.setEngine(engine);
+        std::vector<SolveStep> recorded;
+        ASSERT_TRUE(recorder.solveWithSteps(recorded));
+
+        for (const bool coalesce : {false, true})
+        {
+            Sudoku sudoku(Sudoku::DEFAULT_BOARD);
+            sudoku.setEngine(engine);
+            CompactTrace trace(coalesce);
+            ASSERT_TRUE(sudoku.solveWithSteps(trace));
+            ASSERT_EQ(trace.size(), recorded.size());
+            EXPECT_LE(trace.bytes(), recorded.size() * sizeof(CompactTrace::Code));
+
+            size_t i = 0;
+            for (const SolveStep step : trace)
+            {
+                ASSERT_LT(i, recorded.size());
+                EXPECT_EQ(step.row, recorded[i].row);
+                EXPECT_EQ(step.col, recorded[i].col);
+                EXPECT_EQ(step.value, recorded[i].value);
+                EXPECT_EQ(step.kind, recorded[i].kind);
+                ++i;
+            }
+            EXPECT_EQ(i, recorded.size());
+        }
+    }
+}
@@ -0,0 +1,118 @@
+#include <gtest/gtest.h>
+#include <string_view>
+#include "DifficultyRater.hpp"
+#include "Sudoku.hpp"
+
+namespace
+{
+    /// Parse an 81-character puzzle
+    SudokuBoard board(const std::string_view text)
+    {
+        SudokuBoard result;
+        EXPECT_TRUE(SudokuBoard::parse(text, result));
+        return result;
+    }
+
+    /// Solution found by the search engines
+    SudokuBoard solve(const SudokuBoard &puzzle)
+    {
+        Sudoku sudoku(puzzle);
+        EXPECT_TRUE(sudoku.solve());
+        return sudoku.board();
+    }
+}
+
+/// Test: Each rung of the ladder is reached, names the hardest technique and solves correctly
+TEST(DifficultyRaterTest, LadderSolvesAndNamesHardestTechnique)
+{
+    const std::pair<std::string_view, Technique> cases[] = {
+        {"2.538...7..3.......982.....7.....6..3....179..1.9.5....6.....728.......5....5.8..", Technique::HiddenSingle},
+        {"....6...8...57...35.3..4.1...6..3..2..9..2....1.....9..5.2.9.3.....8.....4...7...", Technique::NakedSingle},
+        {"57......6.....53...6.1..8....2.....58.........1..54........82.7..92.1......94.13.", Technique::Pointing},
+        {"...1.....1..4...864..93..7.2......6...4..52.......39.4....9.8.559.........7..8...", Technique::Claiming},
+        {".....57.8..278.........21.4...8.6....7941....61..........2.8.6.56....9.......14..", Technique::NakedPair},
+        {"....56..34......59.32.7.....48.9.32..9.2..1.8.................6..5.2......7..18..", Technique::XWing},
+        {"..6....4...5...3...427...6........3..3..561.4...8..6..1..9.382.6..4.8..9.........", Technique::HiddenPair},
+        {"9...268..2..8....1...1.46...9..5.....1...79....7.............3.7.85...4..43....87", Technique::NakedTriple},
+        {"..1.....9.....12...3.....48..2.568...97........6.7....1..3...5....5287.......43..", Technique::Swordfish},
+        {".8..712.......8..14..59.8..9.2.3....81......6......7.....61..5...69....42........", Technique::HiddenTriple},
+        {".....6.....5.....841......715.9..6..9......3.3..1......9...3.1....5.87..73...4.9.", Technique::XYWing},
+        {"....382.49......3...1.....81.28..7......1.9..4....56..82.........639.....5.6.....", Technique::XYChain},
+    };
+
+    DifficultyRater rater;
+    for (const auto &[text, technique]: cases)
+    {
+        const SudokuBoard puzzle = board(text);
+        const Rating rating = rater.rate(puzzle);
+        ASSERT_TRUE(rating.valid) << text;
+        ASSERT_TRUE(rating.solved) << text;
+        EXPECT_EQ(rating.hardest, technique) << text;
+        EXPECT_GT(rating.uses[static_cast<size_t>(technique)], 0) << text;
+        EXPECT_EQ(rating.uses[static_cast<size_t>(Technique::Trial)], 0) << text;
+        EXPECT_DOUBLE_EQ(rating.score, DifficultyRater::score(technique));
+        EXPECT_EQ(rating.difficulty, DifficultyRater::difficulty(technique));
+        EXPECT_EQ(rater.board(), solve(puzzle)) << text;
+    }
+}
+
+/// Test: A puzzle beyond the ladder stops short, keeping only sound deductions
+TEST(DifficultyRaterTest, StuckPuzzleKeepsSolutionCandidates)
+{
+    const SudokuBoard puzzle = board(".1.2.876...75.6.14...........2.5....83.....51...3.....34.1.72......2....1.....94.");
+    const SudokuBoard solution = solve(puzzle);
+
+    DifficultyRater rater;
+    const Rating rating = rater.rate(puzzle);
+    ASSERT_TRUE(rating.valid);
+    EXPECT_FALSE(rating.solved);
+    EXPECT_EQ(rating.hardest, Technique::Trial);
+    EXPECT_EQ(rating.difficulty, Difficulty::Extreme);
+    EXPECT_DOUBLE_EQ(rating.score, 10.0);
+
+    const SudokuBoard reached = rater.board();
+    for (int cell = 0; cell < SudokuBoard::CELLS; ++cell)
+    {
+        const auto i = static_cast<size_t>(cell);
+        if (reached.cells[i] != 0)
+            EXPECT_EQ(reached.cells[i], solution.cells[i]) << "cell " << cell;
+        else
+            EXPECT_NE(rater.candidates(cell) & (1U << (solution.cells[i] - 1)), 0U) << "cell " << cell;
+    }
+}
+
+/// Test: Clashing givens and emptied units are reported as invalid
+TEST(DifficultyRaterTest, InvalidGivensAreRejected)
+{
+    DifficultyRater rater;
+    SudokuBoard clash;
+    clash.set(0, 0, 5);
+    clash.set(0, 8, 5);
+    EXPECT_FALSE(rater.rate(clash).valid);
+
+    // Row 0 holds 1-8 and column 8 holds a 9 further down: no place for 9 in row 0
+    SudokuBoard noRoom;
+    for (int col = 0; col < 8; ++col)
+        noRoom.set(0, col, col + 1);
+    noRoom.set(4, 8, 9);
+    EXPECT_FALSE(rater.rate(noRoom).valid);
+
+    // The rater is reusable after a failure
+    const SudokuBoard puzzle = board("2.538...7..3.......982.....7.....6..3....179..1.9.5....6.....728.......5....5.8..");
+    EXPECT_TRUE(rater.rate(puzzle).solved);
+}
+
+/// Test: Scores and buckets never decrease along the ladder
+TEST(DifficultyRaterTest, ScoresFollowLadderOrder)
+{
+    for (size_t i = 1; i < TECHNIQUE_COUNT; ++i)
+    {
+        const auto easier = static_cast<Technique>(i - 1);
+        const auto harder = static_cast<Technique>(i);
+        EXPECT_LT(DifficultyRater::score(easier), DifficultyRater::score(harder));
+        EXPECT_LE(DifficultyRater::difficulty(easier), DifficultyRater::difficulty(harder));
+        EXPECT_FALSE(DifficultyRater::name(harder).empty());
+    }
+    EXPECT_EQ(DifficultyRater::difficulty(Technique::HiddenSingle), Difficulty::Easy);
+    EXPECT_EQ(DifficultyRater::difficulty(Technique::Trial), Difficulty::Extreme);
+}
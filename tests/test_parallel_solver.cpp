@@ -0,0 +1,71 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include "ParallelSolver.hpp"
+#include "Sudoku.hpp"
+
+namespace
+{
+    /// Hard puzzle with a single solution (same as Sudoku::DEFAULT_BOARD)
+    const SudokuBoard hardPuzzle = Sudoku::DEFAULT_BOARD;
+}
+
+/// Test: Parallel solve matches the sequential result for every engine
+TEST(ParallelSolverTest, SolvesLikeSequential)
+{
+    Sudoku reference(hardPuzzle);
+    ASSERT_TRUE(reference.solve());
+
+    ThreadPool pool(4);
+    ParallelSolver parallel(pool);
+    for (const auto &entry : SolverRegistry::engines())
+    {
+        if (entry.kind == EngineKind::Naive)
+            continue; // too slow on this puzzle even when split
+        parallel.setEngine(entry.kind);
+        SudokuBoard board = hardPuzzle;
+        ASSERT_TRUE(parallel.solve(board)) << entry.id;
+        EXPECT_EQ(board, reference.board()) << entry.id;
+        EXPECT_GT(parallel.stats().nodes, 0u) << entry.id;
+    }
+
+    SudokuBoard conflict = hardPuzzle;
+    conflict.set(0, 1, 8);
+    EXPECT_FALSE(parallel.solve(conflict));
+}
+
+/// Test: Subtree counts add up to the sequential count and respect the limit
+TEST(ParallelSolverTest, AggregatesCounts)
+{
+    SudokuBoard loose = hardPuzzle;
+    loose.set(0, 0, 0);
+    const auto sequential = SolverRegistry::create(EngineKind::Propagation);
+    const std::uint64_t total = sequential->countSolutions(loose, 1000);
+    ASSERT_GT(total, 1u);
+
+    ThreadPool pool(3);
+    ParallelSolver parallel(pool);
+    EXPECT_EQ(parallel.countSolutions(loose, 1000), total);
+    EXPECT_EQ(parallel.countSolutions(hardPuzzle, 2), 1u);
+    EXPECT_EQ(parallel.countSolutions(SudokuBoard{}, 50), 50u);
+    EXPECT_EQ(parallel.countSolutions(SudokuBoard{}, 0), 0u);
+}
+
+/// Test: A raised cancellation flag aborts both the parallel and the sequential search
+TEST(ParallelSolverTest, CancelTokenStopsSearch)
+{
+    std::atomic<bool> cancel{true};
+
+    ThreadPool pool(2);
+    ParallelSolver parallel(pool);
+    parallel.setCancelToken(&cancel);
+    SudokuBoard board = hardPuzzle;
+    EXPECT_FALSE(parallel.solve(board));
+    EXPECT_EQ(board, hardPuzzle);
+
+    const auto engine = SolverRegistry::create(EngineKind::Mrv);
+    engine->setCancelToken(&cancel);
+    board = hardPuzzle;
+    EXPECT_FALSE(engine->solve(board, nullptr));
+    cancel = false;
+    EXPECT_TRUE(engine->solve(board, nullptr));
+}
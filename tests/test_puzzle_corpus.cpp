@@ -0,0 +1,192 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include "PuzzleCorpus.hpp"
+#include "PuzzleGenerator.hpp"
+#include "SolverEngine.hpp"
+
+namespace
+{
+    /// Corpus file in the temp directory, removed at scope exit
+    struct TempFile
+    {
+        std::string path;
+
+        explicit TempFile(const std::string &name)
+            : path((std::filesystem::temp_directory_path() / name).string())
+        {
+        }
+
+        ~TempFile() { std::remove(path.c_str()); }
+    };
+}
+
+/// Test: Packing is lossless, keeps the difficulty nibble and uses 41 bytes
+TEST(PuzzleCorpusTest, PackRoundTrip)
+{
+    PuzzleGenerator generator(11);
+    for (int i = 0; i < 10; ++i)
+    {
+        const SudokuBoard board = i % 2 == 0 ? generator.generate() : generator.solvedGrid();
+        const auto record = PuzzleCorpus::pack(board, static_cast<std::uint8_t>(i % 5));
+        static_assert(sizeof(record) == PuzzleCorpus::RECORD_SIZE);
+        EXPECT_EQ(PuzzleCorpus::unpack(record), board);
+        EXPECT_EQ(record.back() >> 4, i % 5);
+    }
+}
+
+/// Test: Written puzzles map back in order with their flags, difficulties and bucket index
+TEST(PuzzleCorpusTest, WriteAndMapRatedCorpus)
+{
+    const TempFile file("sudoku_corpus_rated.sdkc");
+    PuzzleGenerator generator(3);
+    DifficultyRater rater;
+    std::vector<SudokuBoard> puzzles;
+    std::vector<Difficulty> levels;
+
+    CorpusWriter writer;
+    ASSERT_TRUE(writer.open(file.path));
+    for (int i = 0; i < 200; ++i)
+    {
+        puzzles.push_back(generator.generate(i % 2 == 0 ? PuzzleGenerator::MIN_CLUES : 30));
+        levels.push_back(rater.rate(puzzles.back()).difficulty);
+        writer.add(puzzles.back(), levels.back());
+    }
+    ASSERT_TRUE(writer.finish(true));
+    EXPECT_EQ(std::filesystem::file_size(file.path),
+              PuzzleCorpus::HEADER_SIZE + 200 * (PuzzleCorpus::RECORD_SIZE + 4));
+    EXPECT_TRUE(PuzzleCorpus::isCorpus(file.path));
+
+    PuzzleCorpus corpus;
+    std::string error;
+    ASSERT_TRUE(corpus.open(file.path, &error)) << error;
+    ASSERT_EQ(corpus.size(), puzzles.size());
+    EXPECT_TRUE(corpus.unique());
+    EXPECT_TRUE(corpus.rated());
+    for (size_t i = 0; i < puzzles.size(); ++i)
+    {
+        EXPECT_EQ(corpus.at(i), puzzles[i]);
+        EXPECT_EQ(corpus.difficulty(i), levels[i]);
+    }
+
+    // Every puzzle appears exactly once, in its own bucket and in file order
+    size_t total = 0;
+    for (size_t b = 0; b < DIFFICULTY_COUNT; ++b)
+    {
+        const auto level = static_cast<Difficulty>(b);
+        const size_t n = corpus.bucketSize(level);
+        EXPECT_EQ(n, static_cast<size_t>(std::ranges::count(levels, level)));
+        for (size_t k = 0; k < n; ++k)
+        {
+            const auto index = corpus.bucketAt(level, k);
+            ASSERT_TRUE(index.has_value());
+            EXPECT_EQ(levels[*index], level);
+            if (k > 0)
+            {
+                EXPECT_LT(corpus.bucketAt(level, k - 1), index);
+            }
+        }
+        EXPECT_EQ(corpus.bucketAt(level, n), std::nullopt);
+        total += n;
+    }
+    EXPECT_EQ(total, puzzles.size());
+
+    // Moves transfer the mapping
+    PuzzleCorpus moved = std::move(corpus);
+    EXPECT_FALSE(corpus.isOpen());
+    EXPECT_EQ(moved.at(7), puzzles[7]);
+    moved.close();
+
+    // An index entry past the last record is refused instead of read (entry 0 opens the lowest bucket)
+    std::fstream bytes(file.path, std::ios::binary | std::ios::in | std::ios::out);
+    bytes.seekp(static_cast<std::streamoff>(PuzzleCorpus::HEADER_SIZE + 200 * PuzzleCorpus::RECORD_SIZE));
+    bytes.write("\xFF\xFF\xFF\xFF", 4);
+    bytes.close();
+    ASSERT_TRUE(corpus.open(file.path));
+    EXPECT_EQ(corpus.bucketAt(std::ranges::min(levels), 0), std::nullopt);
+}
+
+/// Test: Unrated files have no buckets; damaged or foreign files are refused
+TEST(PuzzleCorpusTest, UnratedAndInvalidFiles)
+{
+    const TempFile file("sudoku_corpus_plain.sdkc");
+    PuzzleGenerator generator(4);
+    CorpusWriter writer;
+    ASSERT_TRUE(writer.open(file.path));
+    writer.add(generator.generate());
+    writer.add(generator.generate(), Difficulty::Easy); // one unrated record makes the file unrated
+    ASSERT_TRUE(writer.finish(false));
+
+    PuzzleCorpus corpus;
+    ASSERT_TRUE(corpus.open(file.path));
+    EXPECT_EQ(corpus.size(), 2u);
+    EXPECT_FALSE(corpus.unique());
+    EXPECT_FALSE(corpus.rated());
+    EXPECT_EQ(corpus.bucketSize(Difficulty::Easy), 0u);
+    EXPECT_EQ(corpus.difficulty(0), std::nullopt);
+    EXPECT_EQ(corpus.difficulty(1), Difficulty::Easy);
+    corpus.close();
+
+    // Truncated: the header promises two records
+    std::filesystem::resize_file(file.path, PuzzleCorpus::HEADER_SIZE + PuzzleCorpus::RECORD_SIZE);
+    std::string error;
+    EXPECT_FALSE(corpus.open(file.path, &error));
+    EXPECT_NE(error.find("truncated"), std::string::npos);
+
+    // Not a corpus at all
+    std::ofstream(file.path) << std::string(200, '.') << '\n';
+    EXPECT_FALSE(PuzzleCorpus::isCorpus(file.path));
+    EXPECT_FALSE(corpus.open(file.path, &error));
+    EXPECT_FALSE(corpus.isOpen());
+    EXPECT_FALSE(corpus.open(file.path + ".missing"));
+}
+
+/// Test: Records with cell nibbles above 9 are flagged, and Dlx refuses them instead of misindexing
+TEST(PuzzleCorpusTest, DamagedRecordsAreFlagged)
+{
+    const TempFile file("sudoku_corpus_damaged.sdkc");
+    PuzzleGenerator generator(5);
+    CorpusWriter writer;
+    ASSERT_TRUE(writer.open(file.path));
+    for (int i = 0; i < 3; ++i)
+        writer.add(generator.generate(), Difficulty::Easy);
+    ASSERT_TRUE(writer.finish(true));
+
+    // Record 1: cell 0 becomes 12; record 2: cell 80 (low nibble of the last byte) becomes 15
+    std::fstream bytes(file.path, std::ios::binary | std::ios::in | std::ios::out);
+    const auto recordAt = [](const std::size_t index) {
+        return static_cast<std::streamoff>(PuzzleCorpus::HEADER_SIZE + index * PuzzleCorpus::RECORD_SIZE);
+    };
+    char byte = 0;
+    bytes.seekg(recordAt(1));
+    bytes.get(byte);
+    bytes.seekp(recordAt(1));
+    bytes.put(static_cast<char>((byte & 0xF0) | 0xC));
+    bytes.seekg(recordAt(2) + static_cast<std::streamoff>(PuzzleCorpus::RECORD_SIZE - 1));
+    bytes.get(byte);
+    bytes.seekp(recordAt(2) + static_cast<std::streamoff>(PuzzleCorpus::RECORD_SIZE - 1));
+    bytes.put(static_cast<char>((byte & 0xF0) | 0xF));
+    bytes.close();
+
+    PuzzleCorpus corpus;
+    ASSERT_TRUE(corpus.open(file.path));
+    EXPECT_TRUE(corpus.valid(0));
+    EXPECT_FALSE(corpus.valid(1));
+    EXPECT_FALSE(corpus.valid(2));
+    EXPECT_EQ(corpus.at(1).cells[0], 12);
+    EXPECT_EQ(corpus.at(2).cells[80], 15);
+    EXPECT_EQ(corpus.difficulty(2), Difficulty::Easy); // the difficulty nibble is untouched
+
+    const auto dlx = SolverRegistry::create(EngineKind::Dlx);
+    for (const std::size_t index : {std::size_t{1}, std::size_t{2}})
+    {
+        SudokuBoard board = corpus.at(index);
+        EXPECT_FALSE(dlx->solve(board, nullptr)) << index;
+        EXPECT_EQ(dlx->countSolutions(corpus.at(index), 2), 0u) << index;
+    }
+    SudokuBoard good = corpus.at(0);
+    EXPECT_TRUE(dlx->solve(good, nullptr));
+}
@@ -0,0 +1,89 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include "PuzzleGenerator.hpp"
+#include "Sudoku.hpp"
+
+namespace
+{
+    /// Number of filled cells
+    int clueCount(const SudokuBoard &board)
+    {
+        return static_cast<int>(std::ranges::count_if(board.cells, [](auto v) { return v != 0; }));
+    }
+}
+
+/// Test: Generated puzzles are unique, hit the clue target and agree with their solution
+TEST(PuzzleGeneratorTest, UniqueAtTargetClues)
+{
+    PuzzleGenerator generator(42);
+    for (int i = 0; i < 20; ++i)
+    {
+        SudokuBoard solution;
+        const SudokuBoard puzzle = generator.generate(30, &solution);
+        EXPECT_EQ(clueCount(puzzle), 30);
+        EXPECT_EQ(clueCount(solution), SudokuBoard::CELLS);
+
+        Sudoku sudoku(puzzle);
+        ASSERT_TRUE(sudoku.hasUniqueSolution());
+        ASSERT_TRUE(sudoku.solve());
+        EXPECT_EQ(sudoku.board(), solution);
+    }
+}
+
+/// Test: Unreachable targets end in a minimal puzzle - every remaining clue is needed
+TEST(PuzzleGeneratorTest, LowTargetGivesMinimalPuzzle)
+{
+    PuzzleGenerator generator(7);
+    const SudokuBoard puzzle = generator.generate(PuzzleGenerator::MIN_CLUES);
+    EXPECT_GE(clueCount(puzzle), PuzzleGenerator::MIN_CLUES);
+    EXPECT_TRUE(Sudoku(puzzle).hasUniqueSolution());
+
+    for (size_t i = 0; i < puzzle.cells.size(); ++i)
+    {
+        if (puzzle.cells[i] == 0)
+            continue;
+        SudokuBoard fewer = puzzle;
+        fewer.cells[i] = 0;
+        EXPECT_FALSE(Sudoku(fewer).hasUniqueSolution()) << "clue " << i << " is redundant";
+    }
+}
+
+/// Test: Same seed, same puzzles; the batch does not depend on the pool size
+TEST(PuzzleGeneratorTest, DeterministicPerSeed)
+{
+    PuzzleGenerator a(123);
+    PuzzleGenerator b(123);
+    EXPECT_EQ(a.generate(), b.generate());
+    EXPECT_EQ(a.solvedGrid(), b.solvedGrid());
+
+    ThreadPool one(1);
+    ThreadPool three(3);
+    const auto first = PuzzleGenerator::generateMany(one, 150, 28, 99);
+    const auto second = PuzzleGenerator::generateMany(three, 150, 28, 99);
+    ASSERT_EQ(first.size(), 150u);
+    EXPECT_EQ(first, second);
+    EXPECT_NE(first.front(), first.back());
+    EXPECT_TRUE(PuzzleGenerator::generateMany(one, 0, 28, 99).empty());
+}
+
+/// Test: Difficulty targets give unique puzzles the rater puts in the requested bucket
+TEST(PuzzleGeneratorTest, DifficultyTargetIsMet)
+{
+    PuzzleGenerator generator(2024);
+    DifficultyRater rater;
+    for (size_t i = 0; i < DIFFICULTY_COUNT; ++i)
+    {
+        const auto difficulty = static_cast<Difficulty>(i);
+        Rating rating;
+        const SudokuBoard puzzle = generator.generate(difficulty, nullptr, &rating);
+        EXPECT_EQ(rating.difficulty, difficulty) << DifficultyRater::name(difficulty);
+        EXPECT_EQ(rater.rate(puzzle).difficulty, difficulty);
+        EXPECT_TRUE(Sudoku(puzzle).hasUniqueSolution());
+    }
+
+    ThreadPool pool(2);
+    const auto hard = PuzzleGenerator::generateMany(pool, 10, Difficulty::Hard, 5);
+    ASSERT_EQ(hard.size(), 10u);
+    for (const auto &puzzle: hard)
+        EXPECT_EQ(rater.rate(puzzle).difficulty, Difficulty::Hard);
+}
@@ -0,0 +1,185 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "Canonicalizer.hpp"
+#include "PuzzleGenerator.hpp"
+#include "SolutionCache.hpp"
+#include "Sudoku.hpp"
+
+namespace
+{
+    /// Cache file in the temp directory, removed at scope exit
+    struct TempFile
+    {
+        std::string path;
+
+        explicit TempFile(const std::string &name)
+            : path((std::filesystem::temp_directory_path() / name).string())
+        {
+        }
+
+        ~TempFile() { std::remove(path.c_str()); }
+    };
+
+    /// Distinct boards usable as keys (contents need not be canonical for the cache itself)
+    SudokuBoard keyBoard(const int i)
+    {
+        SudokuBoard board;
+        board.set(i / 9 % 9, i % 9, 1 + i / 81 % 9);
+        board.set(8, 8, 1 + i % 7);
+        return board;
+    }
+
+    /// Distinct keys whose givens agree with solution: its first 10 + i cells
+    SudokuBoard keyBoard(const int i, const SudokuBoard &solution)
+    {
+        SudokuBoard board;
+        std::copy_n(solution.cells.begin(), 10 + i, board.cells.begin());
+        return board;
+    }
+}
+
+/// Test: The least recently used entry is evicted; lookups refresh recency
+TEST(SolutionCacheTest, EvictsLeastRecentlyUsed)
+{
+    SolutionCache cache(3);
+    const SudokuBoard solution = PuzzleGenerator(1).solvedGrid();
+    for (int i = 0; i < 3; ++i) cache.insert(keyBoard(i), solution);
+    EXPECT_EQ(cache.size(), 3u);
+
+    ASSERT_TRUE(cache.find(keyBoard(0)).has_value()); // 1 is now the oldest
+    cache.insert(keyBoard(3), solution);
+    EXPECT_EQ(cache.size(), 3u);
+    EXPECT_FALSE(cache.find(keyBoard(1)).has_value());
+    EXPECT_TRUE(cache.find(keyBoard(0)).has_value());
+    EXPECT_TRUE(cache.find(keyBoard(2)).has_value());
+    EXPECT_TRUE(cache.find(keyBoard(3)).has_value());
+    EXPECT_EQ(cache.hits(), 4u);
+    EXPECT_EQ(cache.misses(), 1u);
+
+    // Heavy churn keeps exactly the newest entries reachable
+    SolutionCache small(64);
+    for (int i = 0; i < 500; ++i) small.insert(keyBoard(i), solution);
+    for (int i = 0; i < 500; ++i) EXPECT_EQ(small.find(keyBoard(i)).has_value(), i >= 436) << i;
+}
+
+/// Test: A saved cache loads back with its entries and recency order; foreign files are refused
+TEST(SolutionCacheTest, SaveAndLoadRoundTrip)
+{
+    const TempFile file("sudoku_solutions.cache");
+    PuzzleGenerator generator(6);
+    SolutionCache cache(8);
+    std::vector<SudokuBoard> solutions;
+    for (int i = 0; i < 8; ++i)
+    {
+        solutions.push_back(generator.solvedGrid());
+        cache.insert(keyBoard(i, solutions.back()), solutions.back());
+    }
+    ASSERT_TRUE(cache.find(keyBoard(0, solutions[0])).has_value()); // oldest is now 1
+    ASSERT_TRUE(cache.save(file.path));
+
+    SolutionCache loaded(8);
+    ASSERT_TRUE(loaded.load(file.path));
+    EXPECT_EQ(loaded.size(), 8u);
+    for (int i = 0; i < 8; ++i)
+    {
+        EXPECT_EQ(loaded.find(keyBoard(i, solutions[static_cast<size_t>(i)])), solutions[static_cast<size_t>(i)]);
+    }
+
+    // A smaller cache keeps the most recently used entries
+    SolutionCache smaller(2);
+    ASSERT_TRUE(smaller.load(file.path));
+    EXPECT_EQ(smaller.size(), 2u);
+    EXPECT_TRUE(smaller.find(keyBoard(0, solutions[0])).has_value());
+    EXPECT_TRUE(smaller.find(keyBoard(7, solutions[7])).has_value());
+
+    std::ofstream(file.path) << "not a cache";
+    EXPECT_FALSE(loaded.load(file.path));
+    EXPECT_EQ(loaded.size(), 0u);
+    EXPECT_FALSE(loaded.load(file.path + ".missing"));
+}
+
+/// Test: Records with out-of-range digits or a solution that is not a grid matching its key are skipped
+TEST(SolutionCacheTest, LoadSkipsCorruptRecords)
+{
+    const TempFile file("sudoku_solutions_corrupt.cache");
+    PuzzleGenerator generator(7);
+    SolutionCache cache(8);
+    std::vector<SudokuBoard> solutions;
+    for (int i = 0; i < 4; ++i)
+    {
+        solutions.push_back(generator.solvedGrid());
+        cache.insert(keyBoard(i, solutions.back()), solutions.back());
+    }
+    SudokuBoard wrongKey = keyBoard(3, solutions[3]);
+    wrongKey.cells[0] = static_cast<std::uint8_t>(wrongKey.cells[0] % 9 + 1);
+    cache.insert(wrongKey, solutions[3]);
+    ASSERT_TRUE(cache.save(file.path));
+
+    // Records are stored oldest first after a 24-byte header: key then solution
+    constexpr std::streamoff HEADER = 24;
+    constexpr auto RECORD = static_cast<std::streamoff>(PuzzleCorpus::RECORD_SIZE);
+    std::fstream bytes(file.path, std::ios::binary | std::ios::in | std::ios::out);
+    bytes.seekp(HEADER + RECORD); // solution of entry 0: nibble above 9
+    bytes.put(static_cast<char>(0xFC));
+    bytes.seekp(HEADER + 3 * RECORD); // solution of entry 1: swap two cells of the first row
+    const auto &first = solutions[1].cells;
+    bytes.put(static_cast<char>(first[1] | first[0] << 4));
+    bytes.close();
+
+    SolutionCache loaded(8);
+    ASSERT_TRUE(loaded.load(file.path));
+    EXPECT_EQ(loaded.size(), 2u);
+    EXPECT_FALSE(loaded.find(keyBoard(0, solutions[0])).has_value());
+    EXPECT_FALSE(loaded.find(keyBoard(1, solutions[1])).has_value());
+    EXPECT_EQ(loaded.find(keyBoard(2, solutions[2])), solutions[2]);
+    EXPECT_EQ(loaded.find(keyBoard(3, solutions[3])), solutions[3]);
+    EXPECT_FALSE(loaded.find(wrongKey).has_value());
+}
+
+/// Test: A transformed copy of a solved puzzle is answered from the cache with its own solution
+TEST(SolutionCacheTest, SudokuSolvesSymmetricCopyFromCache)
+{
+    PuzzleGenerator generator(13);
+    SudokuBoard solution;
+    const SudokuBoard puzzle = generator.generate(PuzzleGenerator::MIN_CLUES, &solution);
+
+    BoardTransform transform;
+    transform.transpose = true;
+    transform.rows = {5, 3, 4, 8, 7, 6, 1, 0, 2};
+    transform.cols = {2, 0, 1, 6, 8, 7, 4, 3, 5};
+    transform.digits = {0, 4, 9, 2, 7, 1, 3, 8, 6, 5};
+    const SudokuBoard copy = transform.apply(puzzle);
+
+    SolutionCache cache;
+    Sudoku sudoku(puzzle);
+    sudoku.setCache(&cache);
+    ASSERT_TRUE(sudoku.solve());
+    EXPECT_FALSE(sudoku.solvedFromCache());
+    EXPECT_EQ(sudoku.board(), solution);
+    EXPECT_EQ(cache.size(), 1u);
+
+    sudoku.reset(copy);
+    ASSERT_TRUE(sudoku.solve());
+    EXPECT_TRUE(sudoku.solvedFromCache());
+    EXPECT_EQ(sudoku.board(), transform.apply(solution));
+    EXPECT_EQ(sudoku.stats().nodes, 0u);
+    EXPECT_EQ(cache.hits(), 1u);
+
+    // Unsolvable boards are not cached; empty boards skip the cache
+    SudokuBoard broken = puzzle;
+    broken.set(0, 0, solution.get(0, 2));
+    broken.set(0, 1, solution.get(0, 2));
+    sudoku.reset(broken);
+    EXPECT_FALSE(sudoku.solve());
+    EXPECT_EQ(cache.size(), 1u);
+
+    sudoku.reset(SudokuBoard{});
+    EXPECT_TRUE(sudoku.solve());
+    EXPECT_FALSE(sudoku.solvedFromCache());
+    EXPECT_EQ(cache.size(), 1u);
+}
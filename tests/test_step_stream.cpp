@@ -0,0 +1,85 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include "SpscRing.hpp"
+#include "StepStream.hpp"
+#include "Sudoku.hpp"
+
+/// Test: Ring keeps FIFO order across many wrap-arounds and reports full/empty
+TEST(StepStreamTest, RingWrapsInOrder)
+{
+    SpscRing<int, 8> ring;
+    int value = 0;
+    EXPECT_FALSE(ring.tryPop(value));
+    for (int i = 0; i < 8; ++i)
+        EXPECT_TRUE(ring.tryPush(i));
+    EXPECT_FALSE(ring.tryPush(8));
+    EXPECT_EQ(ring.size(), 8u);
+
+    int expected = 0;
+    for (int i = 8; i < 1000; ++i)
+    {
+        ASSERT_TRUE(ring.tryPop(value));
+        EXPECT_EQ(value, expected++);
+        ASSERT_TRUE(ring.tryPush(i));
+    }
+}
+
+/// Test: A trace streamed through the bounded queue equals the recorded one
+TEST(StepStreamTest, StreamMatchesRecordedTrace)
+{
+    Sudoku recorder(Sudoku::DEFAULT_BOARD);
+    recorder.setEngine(EngineKind::Mrv);
+    std::vector<SolveStep> recorded;
+    ASSERT_TRUE(recorder.solveWithSteps(recorded));
+    ASSERT_GT(recorded.size(), StepStream::CAPACITY); // producer must block at least once
+
+    StepStream stream;
+    stream.reset(nullptr);
+    std::thread producer([&stream] {
+        Sudoku sudoku(Sudoku::DEFAULT_BOARD);
+        sudoku.setEngine(EngineKind::Mrv);
+        stream.finish(sudoku.solveWithSteps(stream));
+    });
+
+    std::vector<SolveStep> streamed;
+    SolveStep step{};
+    for (bool done = false; !done;)
+    {
+        done = stream.finished(); // checked first: everything pushed before finish() is then visible
+        while (stream.tryPop(step))
+            streamed.push_back(step);
+    }
+    producer.join();
+
+    EXPECT_TRUE(stream.solved());
+    ASSERT_EQ(streamed.size(), recorded.size());
+    for (size_t i = 0; i < recorded.size(); ++i)
+    {
+        EXPECT_EQ(streamed[i].row, recorded[i].row);
+        EXPECT_EQ(streamed[i].col, recorded[i].col);
+        EXPECT_EQ(streamed[i].value, recorded[i].value);
+    }
+}
+
+/// Test: Cancelling releases a producer blocked on a full queue
+TEST(StepStreamTest, CancelReleasesProducer)
+{
+    std::atomic<bool> cancel{false};
+    StepStream stream;
+    stream.reset(&cancel);
+    std::thread producer([&stream, &cancel] {
+        Sudoku sudoku(Sudoku::DEFAULT_BOARD);
+        sudoku.setEngine(EngineKind::Mrv);
+        sudoku.setCancelToken(&cancel);
+        stream.finish(sudoku.solveWithSteps(stream));
+    });
+
+    while (stream.pending() < StepStream::CAPACITY)
+        std::this_thread::yield(); // nobody consumes: the producer fills the ring and waits
+    cancel = true;
+    producer.join();
+    EXPECT_TRUE(stream.finished());
+    EXPECT_FALSE(stream.solved());
+}
@@ -1,4 +1,7 @@
 #include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <thread>
 #include "Sudoku.hpp"
 
 /**
@@ -132,3 +135,340 @@ TEST_F(SudokuTest, GivenCellMarking)
     EXPECT_TRUE(solver.isGiven(0, 0));  // 8 is given
     EXPECT_FALSE(solver.isGiven(0, 1)); // 0 is not given
 }
+
+/// Test: Bitmask engine matches the naive backtracker step for step
+TEST_F(SudokuTest, BitmaskMatchesNaiveSteps)
+{
+    Sudoku naive(solvablePuzzle);
+    naive.setEngine(EngineKind::Naive);
+    std::vector<SolveStep> naiveSteps;
+    ASSERT_TRUE(naive.solveWithSteps(naiveSteps));
+
+    Sudoku bitmask(solvablePuzzle);
+    bitmask.setEngine(EngineKind::Bitmask);
+    std::vector<SolveStep> bitmaskSteps;
+    ASSERT_TRUE(bitmask.solveWithSteps(bitmaskSteps));
+
+    ASSERT_EQ(naiveSteps.size(), bitmaskSteps.size());
+    for (size_t i = 0; i < naiveSteps.size(); ++i)
+    {
+        EXPECT_EQ(naiveSteps[i].row, bitmaskSteps[i].row);
+        EXPECT_EQ(naiveSteps[i].col, bitmaskSteps[i].col);
+        EXPECT_EQ(naiveSteps[i].value, bitmaskSteps[i].value);
+    }
+    for (int r = 0; r < 9; ++r)
+        for (int c = 0; c < 9; ++c)
+            EXPECT_EQ(naive.getCell(r, c), bitmask.getCell(r, c));
+}
+
+/// Test: Conflicting filled cells are rejected before searching
+TEST_F(SudokuTest, ConflictingGivensRejected)
+{
+    auto board = solvablePuzzle;
+    board[8][0] = 8; // column 0 already has 8 at (0,0)
+    Sudoku solver(board);
+    EXPECT_FALSE(solver.solve());
+}
+
+/// Test: Flat board layout and nested-vector conversion layer
+TEST_F(SudokuTest, FlatBoardConversion)
+{
+    const SudokuBoard board(solvablePuzzle);
+    EXPECT_EQ(board.get(0, 0), 8);
+    EXPECT_EQ(board.cells[SudokuBoard::index(1, 3)], 6);
+    EXPECT_EQ(board.toRows(), solvablePuzzle);
+
+    SudokuBoard copy = board;
+    copy.set(0, 1, 1);
+    EXPECT_EQ(board.get(0, 1), 0);
+    EXPECT_FALSE(copy == board);
+
+    Sudoku solver(board);
+    EXPECT_TRUE(solver.solve());
+    EXPECT_EQ(solver.board().get(0, 0), 8);
+
+    // Oversized row literals are clamped to the board
+    const BasicBoard<2> tiny = {{1, 2, 3, 4, 5}, {3, 4, 1, 2}, {0}, {0}, {9, 9, 9, 9}};
+    EXPECT_EQ(tiny.get(0, 3), 4);
+    EXPECT_EQ(tiny.get(1, 0), 3);
+    EXPECT_EQ(tiny.get(3, 3), 0);
+}
+
+/// Test: MRV engine solves a puzzle with an empty top row and its trace replays to the solution
+TEST_F(SudokuTest, MrvSolvesEmptyTopRow)
+{
+    const SudokuBoard puzzle = {
+        {0, 0, 0, 0, 0, 0, 0, 0, 0},
+        {0, 0, 0, 0, 0, 3, 0, 8, 5},
+        {0, 0, 1, 0, 2, 0, 0, 0, 0},
+        {0, 0, 0, 5, 0, 7, 0, 0, 0},
+        {0, 0, 4, 0, 0, 0, 1, 0, 0},
+        {0, 9, 0, 0, 0, 0, 0, 0, 0},
+        {5, 0, 0, 0, 0, 0, 0, 7, 3},
+        {0, 0, 2, 0, 1, 0, 0, 0, 0},
+        {0, 0, 0, 0, 4, 0, 0, 0, 9}};
+
+    Sudoku solver(puzzle);
+    solver.setEngine(EngineKind::Mrv);
+    std::vector<SolveStep> steps;
+    ASSERT_TRUE(solver.solveWithSteps(steps));
+
+    SudokuBoard replay = puzzle;
+    for (const auto &step : steps)
+        replay.set(step.row, step.col, step.value);
+    EXPECT_EQ(replay, solver.board());
+
+    Sudoku check(solver.board());
+    for (int r = 0; r < 9; ++r)
+        for (int c = 0; c < 9; ++c)
+            EXPECT_TRUE(check.isValid(r, c, check.getCell(r, c)));
+}
+
+/// Test: Propagation solves an easy puzzle by deduction alone
+TEST_F(SudokuTest, PropagationSolvesEasyWithoutGuessing)
+{
+    const SudokuBoard easy = {
+        {5, 3, 0, 0, 7, 0, 0, 0, 0},
+        {6, 0, 0, 1, 9, 5, 0, 0, 0},
+        {0, 9, 8, 0, 0, 0, 0, 6, 0},
+        {8, 0, 0, 0, 6, 0, 0, 0, 3},
+        {4, 0, 0, 8, 0, 3, 0, 0, 1},
+        {7, 0, 0, 0, 2, 0, 0, 0, 6},
+        {0, 6, 0, 0, 0, 0, 2, 8, 0},
+        {0, 0, 0, 4, 1, 9, 0, 0, 5},
+        {0, 0, 0, 0, 8, 0, 0, 7, 9}};
+
+    Sudoku solver(easy);
+    solver.setEngine(EngineKind::Propagation);
+    std::vector<SolveStep> steps;
+    ASSERT_TRUE(solver.solveWithSteps(steps));
+
+    EXPECT_EQ(steps.size(), 51u); // one deduction per empty cell, no backtracking
+    for (const auto &step : steps)
+    {
+        EXPECT_EQ(step.kind, StepKind::Deduced);
+        EXPECT_NE(step.value, 0);
+    }
+}
+
+/// Test: Propagation trace on a hard puzzle mixes guesses and deductions and replays correctly
+TEST_F(SudokuTest, PropagationTraceReplays)
+{
+    Sudoku solver(solvablePuzzle);
+    solver.setEngine(EngineKind::Propagation);
+    std::vector<SolveStep> steps;
+    ASSERT_TRUE(solver.solveWithSteps(steps));
+
+    SudokuBoard replay(solvablePuzzle);
+    bool sawGuess = false;
+    bool sawDeduced = false;
+    for (const auto &step : steps)
+    {
+        replay.set(step.row, step.col, step.value);
+        sawGuess |= step.kind == StepKind::Guess;
+        sawDeduced |= step.kind == StepKind::Deduced;
+    }
+    EXPECT_TRUE(sawGuess);
+    EXPECT_TRUE(sawDeduced);
+    EXPECT_EQ(replay, solver.board());
+
+    Sudoku reference(solvablePuzzle);
+    ASSERT_TRUE(reference.solve());
+    EXPECT_EQ(solver.board(), reference.board()); // puzzle has a unique solution
+}
+
+/// Test: Propagation reports contradictions found before any guess
+TEST_F(SudokuTest, PropagationDetectsUnsolvable)
+{
+    Sudoku solver(unsolvablePuzzle);
+    solver.setEngine(EngineKind::Propagation);
+    EXPECT_FALSE(solver.solve());
+}
+
+/// Test: DLX engine agrees with the bitmask engine and can be reused across puzzles
+TEST_F(SudokuTest, DlxSolvesAndReuses)
+{
+    Sudoku reference(solvablePuzzle);
+    ASSERT_TRUE(reference.solve());
+
+    Sudoku solver(solvablePuzzle);
+    solver.setEngine(EngineKind::Dlx);
+    ASSERT_TRUE(solver.solve());
+    EXPECT_EQ(solver.board(), reference.board());
+
+    // Same instance: conflicting puzzle fails, then the original solves again
+    solver.reset(unsolvablePuzzle);
+    EXPECT_FALSE(solver.solve());
+    solver.reset(solvablePuzzle);
+    std::vector<SolveStep> steps;
+    ASSERT_TRUE(solver.solveWithSteps(steps));
+    EXPECT_EQ(solver.board(), reference.board());
+
+    SudokuBoard replay(solvablePuzzle);
+    for (const auto &step : steps)
+        replay.set(step.row, step.col, step.value);
+    EXPECT_EQ(replay, reference.board());
+}
+
+/// Test: Every registered engine solves identical input to the same solution with consistent statistics
+TEST_F(SudokuTest, RegistryEnginesAgree)
+{
+    Sudoku reference(solvablePuzzle);
+    ASSERT_TRUE(reference.solve());
+
+    for (const auto &entry : SolverRegistry::engines())
+    {
+        SCOPED_TRACE(std::string(entry.id));
+        EXPECT_EQ(SolverRegistry::find(entry.id), &entry);
+
+        auto engine = SolverRegistry::create(entry.kind);
+        ASSERT_NE(engine, nullptr);
+        EXPECT_EQ(engine->kind(), entry.kind);
+
+        SudokuBoard board(solvablePuzzle);
+        std::vector<SolveStep> steps;
+        VectorStepSink sink(steps);
+        ASSERT_TRUE(engine->solve(board, &sink));
+        EXPECT_EQ(board, reference.board());
+
+        // Stats count guesses placed/undone, exactly as they appear in the trace
+        std::uint64_t guesses = 0;
+        std::uint64_t undone = 0;
+        for (const auto &step : steps)
+        {
+            if (step.kind != StepKind::Guess)
+                continue;
+            (step.value != 0 ? guesses : undone) += 1;
+        }
+        EXPECT_EQ(engine->stats().nodes, guesses);
+        EXPECT_EQ(engine->stats().backtracks, undone);
+    }
+    EXPECT_EQ(SolverRegistry::find("unknown"), nullptr);
+}
+
+/// Test: 81-character line format used by the batch solver
+TEST_F(SudokuTest, LineFormatRoundTrip)
+{
+    const std::string line =
+        "8..........36......7..9.2...5...7.......457.....1...3...1....68..85...1..9....4..";
+    SudokuBoard board;
+    ASSERT_TRUE(SudokuBoard::parse(line + "\r", board));
+    EXPECT_EQ(board, SudokuBoard(solvablePuzzle));
+    EXPECT_EQ(board.toString(), line);
+
+    SudokuBoard zeros;
+    ASSERT_TRUE(SudokuBoard::parse(std::string(81, '0'), zeros));
+    EXPECT_EQ(zeros, SudokuBoard{});
+
+    EXPECT_FALSE(SudokuBoard::parse(line.substr(0, 80), board));
+    EXPECT_FALSE(SudokuBoard::parse("x" + line.substr(1), board));
+}
+
+/// Test: Solution counting stops at the limit and leaves the board untouched
+TEST_F(SudokuTest, CountSolutionsEarlyExit)
+{
+    Sudoku sudoku(solvablePuzzle);
+    const auto before = sudoku.board();
+    for (const auto &entry : SolverRegistry::engines())
+    {
+        sudoku.setEngine(entry.kind);
+        EXPECT_EQ(sudoku.countSolutions(10), 1U) << entry.id;
+        EXPECT_TRUE(sudoku.hasUniqueSolution()) << entry.id;
+        EXPECT_EQ(sudoku.board(), before);
+    }
+
+    // Empty board has billions of solutions - must return as soon as the limit is hit
+    Sudoku empty(Sudoku::Board{});
+    empty.setEngine(EngineKind::Propagation);
+    EXPECT_EQ(empty.countSolutions(5), 5U);
+    EXPECT_FALSE(empty.hasUniqueSolution());
+    empty.setEngine(EngineKind::Dlx);
+    EXPECT_EQ(empty.countSolutions(5), 5U);
+    EXPECT_EQ(empty.countSolutions(0), 0U);
+
+    // Dropping clues of a unique puzzle: both counting searches must agree exactly
+    Sudoku::Board loose(solvablePuzzle);
+    loose.set(0, 0, 0);
+    const auto propagation = SolverRegistry::create(EngineKind::Propagation);
+    const auto dlx = SolverRegistry::create(EngineKind::Dlx);
+    const std::uint64_t total = propagation->countSolutions(loose, 1000);
+    EXPECT_GT(total, 1U);
+    EXPECT_LT(total, 1000U);
+    EXPECT_EQ(dlx->countSolutions(loose, 1000), total);
+
+    // Conflicting givens have no solutions
+    Sudoku conflict(solvablePuzzle);
+    conflict.setCell(0, 1, 8);
+    EXPECT_EQ(conflict.countSolutions(2), 0U);
+}
+
+/// Test: Profiling fills the detailed counters without changing the search
+TEST_F(SudokuTest, ProfilingCollectsCounters)
+{
+    for (const auto &entry : SolverRegistry::engines())
+    {
+        Sudoku plain(solvablePuzzle);
+        plain.setEngine(entry.kind);
+        ASSERT_TRUE(plain.solve()) << entry.id;
+        const SolveStats off = plain.stats();
+        EXPECT_EQ(off.candidateTests, 0U) << entry.id;
+        EXPECT_EQ(off.maxDepth, 0) << entry.id;
+        EXPECT_EQ(off.searchTime.count(), 0) << entry.id;
+
+        Sudoku profiled(solvablePuzzle);
+        profiled.setEngine(entry.kind);
+        profiled.setProfiling(true);
+        ASSERT_TRUE(profiled.solve()) << entry.id;
+        const SolveStats on = profiled.stats();
+        EXPECT_EQ(profiled.board(), plain.board()) << entry.id;
+        EXPECT_EQ(on.nodes, off.nodes) << entry.id;
+        EXPECT_EQ(on.backtracks, off.backtracks) << entry.id;
+        EXPECT_GE(on.candidateTests, on.nodes) << entry.id; // at least one test per guess
+        EXPECT_GT(on.maxDepth, 0) << entry.id;
+        EXPECT_LE(static_cast<std::uint64_t>(on.maxDepth), on.nodes) << entry.id;
+        EXPECT_GT(on.searchTime.count(), 0) << entry.id;
+        EXPECT_LE(on.propagationTime, on.searchTime) << entry.id;
+    }
+
+    // Only the propagation engine deduces; every empty cell is either guessed or deduced
+    Sudoku propagation(solvablePuzzle);
+    propagation.setEngine(EngineKind::Propagation);
+    propagation.setProfiling(true);
+    std::vector<SolveStep> steps;
+    ASSERT_TRUE(propagation.solveWithSteps(steps));
+    std::uint64_t deduced = 0;
+    for (const auto &step : steps)
+        deduced += step.kind == StepKind::Deduced && step.value != 0 ? 1 : 0;
+    EXPECT_EQ(propagation.stats().deductions, deduced);
+    EXPECT_GT(propagation.stats().propagationTime.count(), 0);
+}
+
+/// Test: Cancelling from another thread aborts a long naive solve promptly
+TEST_F(SudokuTest, CancelTokenAbortsSolve)
+{
+    // Anti-backtracking puzzle: naive search needs seconds
+    const Sudoku::Board hard = {
+        {0, 0, 0, 0, 0, 0, 0, 0, 0},
+        {0, 0, 0, 0, 0, 3, 0, 8, 5},
+        {0, 0, 1, 0, 2, 0, 0, 0, 0},
+        {0, 0, 0, 5, 0, 7, 0, 0, 0},
+        {0, 0, 4, 0, 0, 0, 1, 0, 0},
+        {0, 9, 0, 0, 0, 0, 0, 0, 0},
+        {5, 0, 0, 0, 0, 0, 0, 7, 3},
+        {0, 0, 2, 0, 1, 0, 0, 0, 0},
+        {0, 0, 0, 0, 4, 0, 0, 0, 9}};
+    std::atomic<bool> cancel{false};
+    Sudoku slow(hard);
+    slow.setEngine(EngineKind::Naive);
+    slow.setCancelToken(&cancel);
+
+    std::thread stopper([&cancel] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        cancel = true;
+    });
+    const auto start = std::chrono::steady_clock::now();
+    EXPECT_FALSE(slow.solve());
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    stopper.join();
+    EXPECT_LT(elapsed, std::chrono::milliseconds(500));
+}
@@ -0,0 +1,69 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <future>
+#include <vector>
+#include "ThreadPool.hpp"
+
+/// Test: Every submitted task runs exactly once before the pool is destroyed
+TEST(ThreadPoolTest, RunsAllTasks)
+{
+    std::atomic<int> sum{0};
+    {
+        ThreadPool pool(4);
+        EXPECT_EQ(pool.size(), 4u);
+        for (int i = 1; i <= 1000; ++i)
+            pool.submit([&sum, i] { sum.fetch_add(i, std::memory_order_relaxed); });
+    }
+    EXPECT_EQ(sum.load(), 500500);
+}
+
+/// Test: Workers report their own index; other threads report -1
+TEST(ThreadPoolTest, CurrentWorkerIndex)
+{
+    EXPECT_EQ(ThreadPool::currentWorker(), -1);
+
+    ThreadPool pool(3);
+    std::vector<std::promise<int>> results(32);
+    for (auto &result : results)
+        pool.submit([&result] { result.set_value(ThreadPool::currentWorker()); });
+    for (auto &result : results)
+    {
+        const int index = result.get_future().get();
+        EXPECT_GE(index, 0);
+        EXPECT_LT(index, 3);
+    }
+}
+
+/// Test: Tasks may spawn subtasks from inside the pool (they land on the local deque)
+TEST(ThreadPoolTest, NestedSubmit)
+{
+    std::atomic<int> count{0};
+    {
+        ThreadPool pool(2);
+        for (int i = 0; i < 10; ++i)
+        {
+            pool.submit([&pool, &count] {
+                for (int j = 0; j < 10; ++j)
+                    pool.submit([&count] { count.fetch_add(1, std::memory_order_relaxed); });
+            });
+        }
+    }
+    EXPECT_EQ(count.load(), 100);
+}
+
+/// Test: Deques grow past their initial capacity while every worker is busy
+TEST(ThreadPoolTest, QueueGrowsWhileWorkersBusy)
+{
+    std::atomic<int> sum{0};
+    {
+        ThreadPool pool(2);
+        std::promise<void> gate;
+        const std::shared_future<void> open = gate.get_future().share();
+        for (int i = 0; i < 2; ++i)
+            pool.submit([open] { open.wait(); }); // one per worker (round-robin)
+        for (int i = 1; i <= 1000; ++i)
+            pool.submit([&sum, i] { sum.fetch_add(i, std::memory_order_relaxed); });
+        gate.set_value();
+    }
+    EXPECT_EQ(sum.load(), 500500);
+}
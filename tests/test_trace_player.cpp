@@ -0,0 +1,123 @@
+#include <gtest/gtest.h>
+#include <random>
+#include <vector>
+#include "Sudoku.hpp"
+#include "TracePlayer.hpp"
+
+namespace
+{
+    /// Board after the first count steps, replayed from scratch
+    SudokuBoard replay(const SudokuBoard &start, const std::vector<SolveStep> &steps, size_t count)
+    {
+        SudokuBoard board = start;
+        for (size_t i = 0; i < count; ++i)
+            board.set(steps[i].row, steps[i].col, steps[i].value);
+        return board;
+    }
+}
+
+/// Test: Random seeks (backward, forward, far jumps) land on the same board as a full replay
+TEST(TracePlayerTest, SeekMatchesReplay)
+{
+    const SudokuBoard start = Sudoku::DEFAULT_BOARD;
+    Sudoku sudoku(start);
+    sudoku.setEngine(EngineKind::Mrv);
+    std::vector<SolveStep> steps;
+    ASSERT_TRUE(sudoku.solveWithSteps(steps));
+
+    TracePlayer player(256);
+    player.reset(start);
+    for (const auto &step : steps)
+        player.append(step);
+    ASSERT_EQ(player.size(), steps.size());
+    EXPECT_EQ(player.position(), 0u);
+    EXPECT_EQ(player.frame().board, start);
+
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<size_t> pick(0, steps.size());
+    for (int i = 0; i < 200; ++i)
+    {
+        const size_t target = pick(rng);
+        player.seek(target);
+        ASSERT_EQ(player.position(), target);
+        ASSERT_EQ(player.frame().board, replay(start, steps, target)) << "seek to " << target;
+    }
+
+    // Step backward one at a time near a snapshot boundary
+    player.seek(1030);
+    for (size_t target = 1029; target >= 1020; --target)
+    {
+        player.seek(player.position() - 1);
+        EXPECT_EQ(player.frame().board, replay(start, steps, target));
+    }
+
+    player.seek(steps.size() + 100); // clamped
+    EXPECT_EQ(player.position(), steps.size());
+    EXPECT_EQ(player.frame().board, sudoku.board());
+}
+
+/// Test: Deduced flags follow the trace, and playback can run while steps are appended
+TEST(TracePlayerTest, TracksDeducedCellsWhileRecording)
+{
+    Sudoku sudoku(Sudoku::DEFAULT_BOARD);
+    sudoku.setEngine(EngineKind::Propagation);
+    std::vector<SolveStep> steps;
+    ASSERT_TRUE(sudoku.solveWithSteps(steps));
+
+    TracePlayer player(16);
+    player.reset(Sudoku::DEFAULT_BOARD);
+    for (const auto &step : steps)
+    {
+        player.append(step);
+        const SolveStep shown = player.stepForward();
+        EXPECT_EQ(shown.row, step.row);
+        EXPECT_EQ(shown.col, step.col);
+        const size_t cell = static_cast<size_t>(SudokuBoard::index(step.row, step.col));
+        EXPECT_EQ(player.frame().deduced[cell], step.value != 0 && step.kind == StepKind::Deduced);
+    }
+    EXPECT_EQ(player.frame().board, sudoku.board());
+
+    player.seek(0);
+    EXPECT_TRUE(player.frame().deduced.none());
+}
+
+/// Test: Batched advance touches only the written cells and honours the deadline
+TEST(TracePlayerTest, AdvanceCoalescesCells)
+{
+    const SudokuBoard start = Sudoku::DEFAULT_BOARD;
+    Sudoku sudoku(start);
+    sudoku.setEngine(EngineKind::Mrv);
+    std::vector<SolveStep> steps;
+    ASSERT_TRUE(sudoku.solveWithSteps(steps));
+
+    TracePlayer player(8192);
+    player.reset(start);
+    for (const auto &step : steps)
+        player.append(step);
+
+    // Short batch: exactly the cells written by those steps
+    std::bitset<81> touched;
+    EXPECT_EQ(player.advance(500, touched), 500u);
+    std::bitset<81> expected;
+    for (size_t i = 0; i < 500; ++i)
+        expected.set(static_cast<size_t>(SudokuBoard::index(steps[i].row, steps[i].col)));
+    EXPECT_EQ(touched, expected);
+    EXPECT_EQ(player.frame().board, replay(start, steps, 500));
+
+    // Expired deadline: one clock stride, then stop
+    touched.reset();
+    const size_t applied = player.advance(3 * TracePlayer::CLOCK_STRIDE, touched, std::chrono::steady_clock::now());
+    EXPECT_EQ(applied, TracePlayer::CLOCK_STRIDE);
+    EXPECT_EQ(player.frame().board, replay(start, steps, 500 + applied));
+
+    // Far skip: snapshot path, everything marked
+    touched.reset();
+    const size_t from = player.position();
+    EXPECT_EQ(player.advance(20000, touched), 20000u);
+    EXPECT_TRUE(touched.all());
+    EXPECT_EQ(player.frame().board, replay(start, steps, from + 20000));
+
+    // Clamped at the end of the trace
+    player.advance(steps.size(), touched);
+    EXPECT_EQ(player.position(), steps.size());
+}